@@ -31,3 +31,5 @@ $(TEST)_SRC += $(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
 $(TEST)_DEFS=$(TMK_COMMON_DEFS) $(OPT_DEFS)
 $(TEST)_CONFIG=$(TEST_PATH)/config.h
 VPATH+=$(TOP_DIR)/tests/test_common
+# so code that includes "config.h" itself, like a keyboard's would, gets the test's
+VPATH+=$(TOP_DIR)/$(TEST_PATH)
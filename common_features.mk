@@ -500,6 +500,9 @@ QUANTUM_SRC += $(QUANTUM_DIR)/bootmagic/magic.c
 
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
+# Timestamps (MATRIX_KEY_TIMESTAMPS) are available to every matrix type
+QUANTUM_SRC += $(QUANTUM_DIR)/matrix_key_times.c
+
 CUSTOM_MATRIX ?= no
 
 ifneq ($(strip $(CUSTOM_MATRIX)), yes)
@@ -19,6 +19,10 @@
 
 #pragma once
 
+#ifdef I2C_ASYNC
+#    error "I2C_ASYNC is only supported on ChibiOS"
+#endif
+
 #define I2C_READ 0x01
 #define I2C_WRITE 0x00
 
@@ -57,6 +57,121 @@ static i2c_status_t chibios_to_qmk(const msg_t* status) {
     }
 }
 
+#if defined(I2C_ASYNC)
+typedef struct {
+    uint8_t              address;
+    uint8_t              length;
+    uint16_t             timeout;
+    i2c_async_callback_t callback;
+    void*                arg;
+    uint8_t              data[I2C_ASYNC_TRANSFER_SIZE];
+} i2c_async_transfer_t;
+
+static i2c_async_transfer_t async_queue[I2C_ASYNC_QUEUE_SIZE];
+static uint8_t              async_head    = 0;  // next transfer to queue, only used by the queueing thread
+static uint8_t              async_tail    = 0;  // next transfer to send, only used by the I2C thread
+static volatile uint8_t     async_pending = 0;
+static bool                 async_started = false;
+static semaphore_t          async_queued;
+static binary_semaphore_t   async_done;
+
+/**
+ * @brief This thread sends the queued transfers one after the other,
+ * so that the keyboard task doesn't wait for them.
+ */
+static THD_WORKING_AREA(waI2CThread, 256);
+static THD_FUNCTION(I2CThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&async_queued);
+
+        i2c_async_transfer_t* transfer = &async_queue[async_tail];
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (transfer->address >> 1), transfer->data, transfer->length, 0, 0, TIME_MS2I(transfer->timeout));
+        if (transfer->callback) {
+            transfer->callback(chibios_to_qmk(&status), transfer->arg);
+        }
+
+        async_tail = (async_tail + 1) % I2C_ASYNC_QUEUE_SIZE;
+        chSysLock();
+        async_pending--;
+        chSysUnlock();
+        chBSemSignal(&async_done);
+    }
+}
+
+/**
+ * @brief Wait for a free slot in the queue, starting the I2C thread the first time around.
+ */
+static i2c_async_transfer_t* async_reserve(uint8_t address, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* arg) {
+    if (!async_started) {
+        async_started = true;
+        chSemObjectInit(&async_queued, 0);
+        chBSemObjectInit(&async_done, true);
+        chThdCreateStatic(waI2CThread, sizeof(waI2CThread), HIGHPRIO, I2CThread, NULL);
+    }
+
+    while (async_pending == I2C_ASYNC_QUEUE_SIZE) {
+        chBSemWait(&async_done);
+    }
+
+    i2c_async_transfer_t* transfer = &async_queue[async_head];
+    transfer->address              = address;
+    transfer->length               = length;
+    transfer->timeout              = timeout;
+    transfer->callback             = callback;
+    transfer->arg                  = arg;
+    return transfer;
+}
+
+/**
+ * @brief Hand the reserved transfer over to the I2C thread.
+ */
+static void async_post(void) {
+    async_head = (async_head + 1) % I2C_ASYNC_QUEUE_SIZE;
+    chSysLock();
+    async_pending++;
+    chSysUnlock();
+    chSemSignal(&async_queued);
+}
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* arg) {
+    if (length > I2C_ASYNC_TRANSFER_SIZE) {
+        return I2C_STATUS_ERROR;
+    }
+
+    i2c_async_transfer_t* transfer = async_reserve(address, length, timeout, callback, arg);
+    memcpy(transfer->data, data, length);
+    async_post();
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* arg) {
+    if (length + 1 > I2C_ASYNC_TRANSFER_SIZE) {
+        return I2C_STATUS_ERROR;
+    }
+
+    i2c_async_transfer_t* transfer = async_reserve(devaddr, length + 1, timeout, callback, arg);
+    transfer->data[0]              = regaddr;
+    memcpy(&transfer->data[1], data, length);
+    async_post();
+    return I2C_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Wait until every queued transfer has been sent, and the bus is free for the blocking functions.
+ */
+void i2c_async_wait(void) {
+    while (async_pending) {
+        chBSemWait(&async_done);
+    }
+}
+#else
+#    define i2c_async_wait()
+#endif
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -78,12 +193,14 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    i2c_async_wait();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
@@ -91,6 +208,7 @@ i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length,
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
@@ -98,6 +216,7 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -112,10 +231,14 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return chibios_to_qmk(&status);
 }
 
-void i2c_stop(void) { i2cStop(&I2C_DRIVER); }
+void i2c_stop(void) {
+    i2c_async_wait();
+    i2cStop(&I2C_DRIVER);
+}
@@ -111,3 +111,27 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 void         i2c_stop(void);
+
+#ifdef I2C_ASYNC
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 16
+#    endif
+#    ifndef I2C_ASYNC_TRANSFER_SIZE
+#        ifdef OLED_DRIVER_ENABLE
+/* A block of a 128x64 OLED with the default OLED_BLOCK_SIZE, plus the register byte. */
+#            define I2C_ASYNC_TRANSFER_SIZE 65
+#        else
+#            define I2C_ASYNC_TRANSFER_SIZE 40
+#        endif
+#    endif
+
+/* Called from the I2C thread once a queued transfer has been sent. */
+typedef void (*i2c_async_callback_t)(i2c_status_t status, void* arg);
+
+/* The data is copied into the queue, and sent in the background, in the order the transfers were queued.
+ * They wait for a free slot when the queue is full, and return I2C_STATUS_ERROR if the data doesn't fit in one.
+ * The blocking functions above wait for the queued transfers to be sent first. */
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* arg);
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* arg);
+void         i2c_async_wait(void);
+#endif
@@ -39,6 +39,14 @@ static inline bool __attribute__((nonnull)) send(const uint8_t* source, const si
 static inline int  initiate_transaction(uint8_t sstd_index);
 static inline void usart_clear(void);
 
+#if defined(SERIAL_USART_ASYNC)
+static binary_semaphore_t async_posted;
+static binary_semaphore_t async_done;
+static volatile uint8_t   async_index;
+static volatile int       async_result = TRANSACTION_END;
+static volatile bool      async_busy   = false;
+#endif
+
 /**
  * @brief Clear the receive input queue.
  */
@@ -235,6 +243,29 @@ static inline bool react_to_transactions(void) {
     return true;
 }
 
+#if defined(SERIAL_USART_ASYNC)
+/**
+ * @brief This thread runs on the master and initiates the transactions posted
+ * to it, so that the keyboard task doesn't wait for them.
+ */
+static THD_WORKING_AREA(waMasterThread, 1024);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("usart_master");
+
+    while (true) {
+        chBSemWait(&async_posted);
+
+        /* Clear the receive queue, to start with a clean slate.
+         * Parts of failed transactions or spurious bytes could still be in it. */
+        usart_clear();
+        async_result = initiate_transaction(async_index);
+        async_busy   = false;
+        chBSemSignal(&async_done);
+    }
+}
+#endif
+
 /**
  * @brief Master specific initializations.
  */
@@ -246,8 +277,64 @@ void soft_serial_initiator_init(void) {
 #endif
 
     sdStart(serial_driver, &serial_config);
+
+#if defined(SERIAL_USART_ASYNC)
+    chBSemObjectInit(&async_posted, true);
+    chBSemObjectInit(&async_done, true);
+
+    /* Start transport thread. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
+#endif
 }
 
+#if defined(SERIAL_USART_ASYNC)
+/**
+ * @brief Start a transaction in the background.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return false if the previous transaction is still running.
+ */
+bool soft_serial_transaction_post(int index) {
+    if (async_busy) {
+        return false;
+    }
+
+    async_index = (uint8_t)index;
+    async_busy  = true;
+    chBSemSignal(&async_posted);
+    return true;
+}
+
+/**
+ * @brief Result of the last transaction started in the background.
+ *
+ * @param wait Wait for the transaction to end, rather than return TRANSACTION_PENDING.
+ * @return int TRANSACTION_PENDING while the transaction runs,
+ *             then the result of initiate_transaction().
+ */
+int soft_serial_transaction_poll(bool wait) {
+    while (wait && async_busy) {
+        chBSemWait(&async_done);
+    }
+    return async_busy ? TRANSACTION_PENDING : async_result;
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half, and wait for it.
+ * The transaction runs in the master thread, after any transaction that is already running.
+ */
+int soft_serial_transaction(int index) {
+    soft_serial_transaction_poll(true);
+    int posted_result = async_result;
+
+    soft_serial_transaction_post(index);
+    int result = soft_serial_transaction_poll(true);
+
+    /* Keep the result of the background transaction until it is polled. */
+    async_result = posted_result;
+    return result;
+}
+#else
 /**
  * @brief Start transaction from the master half to the slave half.
  *
@@ -262,6 +349,7 @@ int soft_serial_transaction(int index) {
     usart_clear();
     return initiate_transaction((uint8_t)index);
 }
+#endif
 
 /**
  * @brief Initiate transaction to slave half.
@@ -18,6 +18,7 @@
 #include "is31fl3731.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -53,6 +54,16 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#ifdef I2C_ASYNC
+// a queued transfer is only known to have failed afterwards, so rather than being
+// retried, it's queued ISSI_PERSISTENCE times
+#    if ISSI_PERSISTENCE > 0
+#        define ISSI_TRANSFER_COPIES ISSI_PERSISTENCE
+#    else
+#        define ISSI_TRANSFER_COPIES 1
+#    endif
+#endif
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -64,6 +75,10 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][144];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// one bit per PWM register, set when it has changed since it was last sent
+// the driver starts out cleared by IS31FL3731_init(), just like g_pwm_buffer
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][144 / 8] = {{0}};
+
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
@@ -81,19 +96,57 @@ bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 // 0x0E - R17,G15,G14,G13,G12,G11,G10,G09
 // 0x10 - R16,R15,R14,R13,R12,R11,R10,R09
 
-void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
-    g_twi_transfer_buffer[0] = reg;
-    g_twi_transfer_buffer[1] = data;
+#ifdef I2C_ASYNC
+// counts the transfers that failed in the background, each driver keeps the
+// count it has seen, and sends all of its PWM registers again when it goes up
+static volatile uint8_t g_transfer_failures                    = 0;
+static uint8_t          g_transfer_failures_seen[DRIVER_COUNT] = {0};
+
+static void IS31FL3731_transfer_done(i2c_status_t status, void *arg) {
+    // runs in the I2C thread, which is the only one writing the count
+    // a transfer only fails if all of its copies do, arg is set on the last one
+    static uint8_t failed_copies = 0;
+    if (status != I2C_STATUS_SUCCESS) {
+        failed_copies++;
+    }
+    if (arg) {
+        if (failed_copies == ISSI_TRANSFER_COPIES) {
+            g_transfer_failures++;
+        }
+        failed_copies = 0;
+    }
+}
+#endif
 
-#if ISSI_PERSISTENCE > 0
+static bool IS31FL3731_transmit(uint8_t addr, uint8_t length) {
+    // sends the first length bytes of g_twi_transfer_buffer
+    // returns false if the transfer fails
+#if defined(I2C_ASYNC)
+    // the transfer is queued, and sent while the keyboard task carries on
+    for (uint8_t i = 0; i < ISSI_TRANSFER_COPIES; i++) {
+        bool last = i == ISSI_TRANSFER_COPIES - 1;
+        if (i2c_transmit_async(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT, IS31FL3731_transfer_done, (void *)(uintptr_t)last) != I2C_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+#elif ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) == 0) return true;
     }
+    return false;
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    return i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) == 0;
 #endif
 }
 
+void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+    g_twi_transfer_buffer[0] = reg;
+    g_twi_transfer_buffer[1] = data;
+
+    IS31FL3731_transmit(addr, 2);
+}
+
 void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // assumes bank is already selected
 
@@ -111,14 +164,50 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
-#if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+        IS31FL3731_transmit(addr, 17);
+    }
+}
+
+#define PWM_REGISTER_DIRTY(dirty, reg) ((dirty)[(reg) / 8] & (1 << ((reg) % 8)))
+
+// unchanged registers in between changed ones are sent along with them
+// when that is cheaper than starting a new transfer for the next run
+#define PWM_REGISTER_GAP 2
+
+bool IS31FL3731_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // assumes bank is already selected
+    // if any of the transfers fails function returns false, and the
+    // registers that weren't sent are left dirty
+
+    // transmit each run of changed PWM registers in transfers of up to 16 bytes
+    // g_twi_transfer_buffer[] is 20 bytes
+    for (uint8_t i = 0; i < 144;) {
+        if (!PWM_REGISTER_DIRTY(dirty, i)) {
+            i++;
+            continue;
+        }
+
+        // find where the run ends, end is one past the last changed register
+        uint8_t start = i;
+        uint8_t end   = i + 1;
+        for (uint8_t j = end; j < 144 && j < start + 16 && j - end < PWM_REGISTER_GAP; j++) {
+            if (PWM_REGISTER_DIRTY(dirty, j)) {
+                end = j + 1;
+            }
+        }
+
+        // the PWM registers start at 0x24
+        g_twi_transfer_buffer[0] = 0x24 + start;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + start, end - start);
+        if (!IS31FL3731_transmit(addr, 1 + end - start)) {
+            return false;
+        }
+
+        for (i = start; i < end; i++) {
+            dirty[i / 8] &= ~(1 << (i % 8));
         }
-#else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
-#endif
     }
+    return true;
 }
 
 void IS31FL3731_init(uint8_t addr) {
@@ -133,6 +222,10 @@ void IS31FL3731_init(uint8_t addr) {
     // enable software shutdown
     IS31FL3731_write_register(addr, ISSI_REG_SHUTDOWN, 0x00);
 
+#ifdef I2C_ASYNC
+    // the queued writes have to reach the driver before the delay
+    i2c_async_wait();
+#endif
     // this delay was copied from other drivers, might not be needed
     wait_ms(10);
 
@@ -173,15 +266,23 @@ void IS31FL3731_init(uint8_t addr) {
     IS31FL3731_write_register(addr, ISSI_COMMANDREGISTER, 0);
 }
 
+static void IS31FL3731_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    // only registers whose value actually changes need to be sent again
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver][reg / 8] |= (1 << (reg % 8));
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
         // Subtract 0x24 to get the second index of g_pwm_buffer
-        g_pwm_buffer[led.driver][led.r - 0x24]   = red;
-        g_pwm_buffer[led.driver][led.g - 0x24]   = green;
-        g_pwm_buffer[led.driver][led.b - 0x24]   = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3731_set_pwm_register(led.driver, led.r - 0x24, red);
+        IS31FL3731_set_pwm_register(led.driver, led.g - 0x24, green);
+        IS31FL3731_set_pwm_register(led.driver, led.b - 0x24, blue);
     }
 }
 
@@ -221,8 +322,21 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#ifdef I2C_ASYNC
+    // a transfer has failed since the last update, the driver may be out
+    // of step with the buffer, so send all of it again
+    if (g_transfer_failures_seen[index] != g_transfer_failures) {
+        g_transfer_failures_seen[index] = g_transfer_failures;
+        memset(g_pwm_buffer_dirty[index], 0xFF, sizeof(g_pwm_buffer_dirty[index]));
+        g_pwm_buffer_update_required[index]            = true;
+        g_led_control_registers_update_required[index] = true;
+    }
+#endif
     if (g_pwm_buffer_update_required[index]) {
-        IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // if any of the transfers fail, send the registers left dirty next time
+        if (!IS31FL3731_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index])) {
+            return;
+        }
     }
     g_pwm_buffer_update_required[index] = false;
 }
@@ -32,6 +32,9 @@ extern const is31_led g_is31_leds[DRIVER_LED_TOTAL];
 void IS31FL3731_init(uint8_t addr);
 void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data);
 void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer);
+// Only sends the registers flagged in dirty (one bit per register), and clears their bits.
+// Returns false if a transfer fails, the registers not sent yet are left flagged.
+bool IS31FL3731_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty);
 
 void IS31FL3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void IS31FL3731_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
@@ -41,7 +44,7 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 // This should not be called from an interrupt
 // (eg. from a timer interrupt).
 // Call this while idle (in between matrix scans).
-// If the buffer is dirty, it will update the driver with the buffer.
+// If the buffer is dirty, it will update the driver with the registers that have changed.
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index);
 void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index);
 
@@ -19,6 +19,7 @@
 #include "is31fl3733.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -68,28 +69,53 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// One bit per PWM register, set when it has changed since it was last sent.
+// The driver starts out cleared by IS31FL3733_init(), just like g_pwm_buffer.
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][192 / 8] = {{0}};
+
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
-bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
-    // If the transaction fails function returns false.
-    g_twi_transfer_buffer[0] = reg;
-    g_twi_transfer_buffer[1] = data;
+#ifdef I2C_ASYNC
+// Counts the transfers that failed in the background. Each driver keeps
+// the count it has seen, and sends all of its PWM registers again when it goes up.
+static volatile uint8_t g_transfer_failures                    = 0;
+static uint8_t          g_transfer_failures_seen[DRIVER_COUNT] = {0};
 
-#if ISSI_PERSISTENCE > 0
-    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) != 0) {
+static void IS31FL3733_transfer_done(i2c_status_t status, void *arg) {
+    // Runs in the I2C thread, which is the only one writing the count.
+    if (status != I2C_STATUS_SUCCESS) {
+        g_transfer_failures++;
+    }
+}
+#endif
+
+static bool IS31FL3733_transmit(uint8_t addr, uint8_t length) {
+    // Sends the first length bytes of g_twi_transfer_buffer, ISSI_PERSISTENCE times if set.
+    // If the transaction fails function returns false.
+    for (uint8_t i = 0; i < (ISSI_PERSISTENCE > 0 ? ISSI_PERSISTENCE : 1); i++) {
+#ifdef I2C_ASYNC
+        // The transfer is queued, and sent while the keyboard task carries on.
+        if (i2c_transmit_async(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT, IS31FL3733_transfer_done, NULL) != I2C_STATUS_SUCCESS) {
             return false;
         }
-    }
 #else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) != 0) {
-        return false;
-    }
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) != 0) {
+            return false;
+        }
 #endif
+    }
     return true;
 }
 
+bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+    // If the transaction fails function returns false.
+    g_twi_transfer_buffer[0] = reg;
+    g_twi_transfer_buffer[1] = data;
+
+    return IS31FL3733_transmit(addr, 2);
+}
+
 bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
@@ -106,17 +132,48 @@ bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
-#if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
-                return false;
+        if (!IS31FL3733_transmit(addr, 17)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#define PWM_REGISTER_DIRTY(dirty, reg) ((dirty)[(reg) / 8] & (1 << ((reg) % 8)))
+
+// Unchanged registers in between changed ones are sent along with them
+// when that is cheaper than starting a new transfer for the next run.
+#define PWM_REGISTER_GAP 2
+
+bool IS31FL3733_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // Assumes PG1 is already selected.
+    // If any of the transactions fails function returns false, and the
+    // registers that weren't sent are left dirty.
+    // Transmit each run of changed PWM registers in transfers of up to 16 bytes.
+    for (uint8_t i = 0; i < 192;) {
+        if (!PWM_REGISTER_DIRTY(dirty, i)) {
+            i++;
+            continue;
+        }
+
+        // Find where the run ends, end is one past the last changed register.
+        uint8_t start = i;
+        uint8_t end   = i + 1;
+        for (uint8_t j = end; j < 192 && j < start + 16 && j - end < PWM_REGISTER_GAP; j++) {
+            if (PWM_REGISTER_DIRTY(dirty, j)) {
+                end = j + 1;
             }
         }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+
+        g_twi_transfer_buffer[0] = start;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + start, end - start);
+        if (!IS31FL3733_transmit(addr, 1 + end - start)) {
             return false;
         }
-#endif
+
+        for (i = start; i < end; i++) {
+            dirty[i / 8] &= ~(1 << (i % 8));
+        }
     }
     return true;
 }
@@ -159,18 +216,29 @@ void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // Disable software shutdown.
     IS31FL3733_write_register(addr, ISSI_REG_CONFIGURATION, (sync << 6) | 0x01);
 
-    // Wait 10ms to ensure the device has woken up.
+    // Wait 10ms to ensure the device has woken up, once the queued writes have reached it.
+#ifdef I2C_ASYNC
+    i2c_async_wait();
+#endif
     wait_ms(10);
 }
 
+static void IS31FL3733_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    // Only registers whose value actually changes need to be sent again.
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver][reg / 8] |= (1 << (reg % 8));
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3733_set_pwm_register(led.driver, led.r, red);
+        IS31FL3733_set_pwm_register(led.driver, led.g, green);
+        IS31FL3733_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -210,15 +278,26 @@ void IS31FL3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#ifdef I2C_ASYNC
+    // A transfer has failed since the last update, the driver may be out
+    // of step with the buffer, so send all of it again.
+    if (g_transfer_failures_seen[index] != g_transfer_failures) {
+        g_transfer_failures_seen[index] = g_transfer_failures;
+        memset(g_pwm_buffer_dirty[index], 0xFF, sizeof(g_pwm_buffer_dirty[index]));
+        g_pwm_buffer_update_required[index]            = true;
+        g_led_control_registers_update_required[index] = true;
+    }
+#endif
     if (g_pwm_buffer_update_required[index]) {
         // Firstly we need to unlock the command register and select PG1.
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
         // If any of the transactions fail we risk writing dirty PG0,
-        // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        // refresh page 0 just in case, and try the rest of PG1 again next time.
+        if (!IS31FL3733_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index])) {
             g_led_control_registers_update_required[index] = true;
+            return;
         }
     }
     g_pwm_buffer_update_required[index] = false;
@@ -20,6 +20,7 @@
 #include "i2c_master.h"
 #include "wait.h"
 #include "progmem.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -57,6 +58,16 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#ifdef I2C_ASYNC
+// a queued transfer is only known to have failed afterwards, so rather than being
+// retried, it's queued ISSI_PERSISTENCE times
+#    if ISSI_PERSISTENCE > 0
+#        define ISSI_TRANSFER_COPIES ISSI_PERSISTENCE
+#    else
+#        define ISSI_TRANSFER_COPIES 1
+#    endif
+#endif
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -70,22 +81,64 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// one bit per PWM register, set when it has changed since it was last sent
+// the driver starts out cleared by IS31FL3737_init(), just like g_pwm_buffer
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][192 / 8] = {{0}};
+
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
-void IS31FL3737_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
-    g_twi_transfer_buffer[0] = reg;
-    g_twi_transfer_buffer[1] = data;
+#ifdef I2C_ASYNC
+// counts the transfers that failed in the background, each driver keeps the
+// count it has seen, and sends all of its PWM registers again when it goes up
+static volatile uint8_t g_transfer_failures                    = 0;
+static uint8_t          g_transfer_failures_seen[DRIVER_COUNT] = {0};
+
+static void IS31FL3737_transfer_done(i2c_status_t status, void *arg) {
+    // runs in the I2C thread, which is the only one writing the count
+    // a transfer only fails if all of its copies do, arg is set on the last one
+    static uint8_t failed_copies = 0;
+    if (status != I2C_STATUS_SUCCESS) {
+        failed_copies++;
+    }
+    if (arg) {
+        if (failed_copies == ISSI_TRANSFER_COPIES) {
+            g_transfer_failures++;
+        }
+        failed_copies = 0;
+    }
+}
+#endif
 
-#if ISSI_PERSISTENCE > 0
+static bool IS31FL3737_transmit(uint8_t addr, uint8_t length) {
+    // sends the first length bytes of g_twi_transfer_buffer
+    // returns false if the transfer fails
+#if defined(I2C_ASYNC)
+    // the transfer is queued, and sent while the keyboard task carries on
+    for (uint8_t i = 0; i < ISSI_TRANSFER_COPIES; i++) {
+        bool last = i == ISSI_TRANSFER_COPIES - 1;
+        if (i2c_transmit_async(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT, IS31FL3737_transfer_done, (void *)(uintptr_t)last) != I2C_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+#elif ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) == 0) return true;
     }
+    return false;
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    return i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) == 0;
 #endif
 }
 
+void IS31FL3737_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+    g_twi_transfer_buffer[0] = reg;
+    g_twi_transfer_buffer[1] = data;
+
+    IS31FL3737_transmit(addr, 2);
+}
+
 void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // assumes PG1 is already selected
 
@@ -102,14 +155,49 @@ void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
-#if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+        IS31FL3737_transmit(addr, 17);
+    }
+}
+
+#define PWM_REGISTER_DIRTY(dirty, reg) ((dirty)[(reg) / 8] & (1 << ((reg) % 8)))
+
+// unchanged registers in between changed ones are sent along with them
+// when that is cheaper than starting a new transfer for the next run
+#define PWM_REGISTER_GAP 2
+
+bool IS31FL3737_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // assumes PG1 is already selected
+    // if any of the transfers fails function returns false, and the
+    // registers that weren't sent are left dirty
+
+    // transmit each run of changed PWM registers in transfers of up to 16 bytes
+    // g_twi_transfer_buffer[] is 20 bytes
+    for (uint8_t i = 0; i < 192;) {
+        if (!PWM_REGISTER_DIRTY(dirty, i)) {
+            i++;
+            continue;
+        }
+
+        // find where the run ends, end is one past the last changed register
+        uint8_t start = i;
+        uint8_t end   = i + 1;
+        for (uint8_t j = end; j < 192 && j < start + 16 && j - end < PWM_REGISTER_GAP; j++) {
+            if (PWM_REGISTER_DIRTY(dirty, j)) {
+                end = j + 1;
+            }
+        }
+
+        g_twi_transfer_buffer[0] = start;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + start, end - start);
+        if (!IS31FL3737_transmit(addr, 1 + end - start)) {
+            return false;
+        }
+
+        for (i = start; i < end; i++) {
+            dirty[i / 8] &= ~(1 << (i % 8));
         }
-#else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
-#endif
     }
+    return true;
 }
 
 void IS31FL3737_init(uint8_t addr) {
@@ -149,20 +237,31 @@ void IS31FL3737_init(uint8_t addr) {
     // Disable software shutdown.
     IS31FL3737_write_register(addr, ISSI_REG_CONFIGURATION, 0x01);
 
-    // Wait 10ms to ensure the device has woken up.
+    // Wait 10ms to ensure the device has woken up, once the queued writes have reached it.
+#ifdef I2C_ASYNC
+    i2c_async_wait();
+#endif
     wait_ms(10);
 }
 
+static void IS31FL3737_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    // only registers whose value actually changes need to be sent again
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver][reg / 8] |= (1 << (reg % 8));
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         // copy the led config from progmem to SRAM
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3737_set_pwm_register(led.driver, led.r, red);
+        IS31FL3737_set_pwm_register(led.driver, led.g, green);
+        IS31FL3737_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -204,12 +303,25 @@ void IS31FL3737_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3737_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#ifdef I2C_ASYNC
+    // a transfer has failed since the last update, the driver may be out
+    // of step with the buffer, so send all of it again
+    if (g_transfer_failures_seen[index] != g_transfer_failures) {
+        g_transfer_failures_seen[index] = g_transfer_failures;
+        memset(g_pwm_buffer_dirty[index], 0xFF, sizeof(g_pwm_buffer_dirty[index]));
+        g_pwm_buffer_update_required[index]            = true;
+        g_led_control_registers_update_required[index] = true;
+    }
+#endif
     if (g_pwm_buffer_update_required[index]) {
         // Firstly we need to unlock the command register and select PG1
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
-        IS31FL3737_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // if any of the transfers fail, send the registers left dirty next time
+        if (!IS31FL3737_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index])) {
+            return;
+        }
     }
     g_pwm_buffer_update_required[index] = false;
 }
@@ -61,6 +61,16 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#ifdef I2C_ASYNC
+// a queued transfer is only known to have failed afterwards, so rather than being
+// retried, it's queued ISSI_PERSISTENCE times
+#    if ISSI_PERSISTENCE > 0
+#        define ISSI_TRANSFER_COPIES ISSI_PERSISTENCE
+#    else
+#        define ISSI_TRANSFER_COPIES 1
+#    endif
+#endif
+
 #define ISSI_MAX_LEDS 351
 
 // Transfer buffer for TWITransmitData()
@@ -76,21 +86,63 @@ uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
 bool    g_pwm_buffer_update_required                      = false;
 bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
+// one bit per PWM register, set when it has changed since it was last sent
+// IS31FL3741_init() flags all of them, so that the first update sends everything
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][(ISSI_MAX_LEDS + 7) / 8] = {{0}};
+
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
-void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
-    g_twi_transfer_buffer[0] = reg;
-    g_twi_transfer_buffer[1] = data;
+#ifdef I2C_ASYNC
+// counts the transfers that failed in the background, all of the PWM
+// registers are sent again when it has gone up since the last update
+static volatile uint8_t g_transfer_failures      = 0;
+static uint8_t          g_transfer_failures_seen = 0;
+
+static void IS31FL3741_transfer_done(i2c_status_t status, void *arg) {
+    // runs in the I2C thread, which is the only one writing the count
+    // a transfer only fails if all of its copies do, arg is set on the last one
+    static uint8_t failed_copies = 0;
+    if (status != I2C_STATUS_SUCCESS) {
+        failed_copies++;
+    }
+    if (arg) {
+        if (failed_copies == ISSI_TRANSFER_COPIES) {
+            g_transfer_failures++;
+        }
+        failed_copies = 0;
+    }
+}
+#endif
 
-#if ISSI_PERSISTENCE > 0
+static bool IS31FL3741_transmit(uint8_t addr, uint8_t length) {
+    // sends the first length bytes of g_twi_transfer_buffer
+    // returns false if the transfer fails
+#if defined(I2C_ASYNC)
+    // the transfer is queued, and sent while the keyboard task carries on
+    for (uint8_t i = 0; i < ISSI_TRANSFER_COPIES; i++) {
+        bool last = i == ISSI_TRANSFER_COPIES - 1;
+        if (i2c_transmit_async(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT, IS31FL3741_transfer_done, (void *)(uintptr_t)last) != I2C_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+#elif ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) == 0) return true;
     }
+    return false;
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    return i2c_transmit(addr << 1, g_twi_transfer_buffer, length, ISSI_TIMEOUT) == 0;
 #endif
 }
 
+void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+    g_twi_transfer_buffer[0] = reg;
+    g_twi_transfer_buffer[1] = data;
+
+    IS31FL3741_transmit(addr, 2);
+}
+
 bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // unlock the command register and select PG2
     IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
@@ -106,35 +158,66 @@ bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
         g_twi_transfer_buffer[0] = i % 180;
         memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
 
-#if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
+        if (!IS31FL3741_transmit(addr, 19)) {
             return false;
         }
-#endif
     }
 
     // transfer the left cause the total number is 351
     g_twi_transfer_buffer[0] = 162;
     memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
 
-#if ISSI_PERSISTENCE > 0
-    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
+    return IS31FL3741_transmit(addr, 10);
+}
+
+#define PWM_REGISTER_DIRTY(dirty, reg) ((dirty)[(reg) / 8] & (1 << ((reg) % 8)))
+
+// unchanged registers in between changed ones are sent along with them
+// when that is cheaper than starting a new transfer for the next run
+#define PWM_REGISTER_GAP 2
+
+bool IS31FL3741_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // if any of the transfers fails function returns false, and the
+    // registers that weren't sent are left dirty
+
+    // the first 180 registers are on PG0 and the rest on PG1, so a run
+    // never crosses from one to the other
+    // transmit each run of changed PWM registers in transfers of up to 18 bytes
+    // g_twi_transfer_buffer[] is 20 bytes
+    uint8_t page = 0xFF;
+    for (uint16_t i = 0; i < ISSI_MAX_LEDS;) {
+        if (!PWM_REGISTER_DIRTY(dirty, i)) {
+            i++;
+            continue;
+        }
+
+        // find where the run ends, end is one past the last changed register
+        uint16_t page_end = i < 180 ? 180 : ISSI_MAX_LEDS;
+        uint16_t start    = i;
+        uint16_t end      = i + 1;
+        for (uint16_t j = end; j < page_end && j < start + 18 && j - end < PWM_REGISTER_GAP; j++) {
+            if (PWM_REGISTER_DIRTY(dirty, j)) {
+                end = j + 1;
+            }
+        }
+
+        if (page != (start < 180 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1)) {
+            page = start < 180 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1;
+            // unlock the command register and select the page
+            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
+            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page);
+        }
+
+        g_twi_transfer_buffer[0] = start % 180;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + start, end - start);
+        if (!IS31FL3741_transmit(addr, 1 + end - start)) {
             return false;
         }
-    }
-#else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-        return false;
-    }
-#endif
 
+        for (i = start; i < end; i++) {
+            dirty[i / 8] &= ~(1 << (i % 8));
+        }
+    }
     return true;
 }
 
@@ -161,18 +244,33 @@ void IS31FL3741_init(uint8_t addr) {
 
     // IS31FL3741_update_led_scaling_registers(addr, 0xFF, 0xFF, 0xFF);
 
-    // Wait 10ms to ensure the device has woken up.
+    // The PWM registers aren't cleared here, send all of them on the next update.
+    memset(g_pwm_buffer_dirty, 0xFF, sizeof(g_pwm_buffer_dirty));
+    g_pwm_buffer_update_required = true;
+
+    // Wait 10ms to ensure the device has woken up, once the queued writes have reached it.
+#ifdef I2C_ASYNC
+    i2c_async_wait();
+#endif
     wait_ms(10);
 }
 
+static void IS31FL3741_set_pwm_register(uint8_t driver, uint16_t reg, uint8_t value) {
+    // only registers whose value actually changes need to be sent again
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver][reg / 8] |= (1 << (reg % 8));
+        g_pwm_buffer_update_required = true;
+    }
+}
+
 void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r] = red;
-        g_pwm_buffer[led.driver][led.g] = green;
-        g_pwm_buffer[led.driver][led.b] = blue;
-        g_pwm_buffer_update_required    = true;
+        IS31FL3741_set_pwm_register(led.driver, led.r, red);
+        IS31FL3741_set_pwm_register(led.driver, led.g, green);
+        IS31FL3741_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -207,19 +305,30 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr1, uint8_t addr2) {
+#ifdef I2C_ASYNC
+    // a transfer has failed since the last update, the driver may be out
+    // of step with the buffer, so send all of it again
+    if (g_transfer_failures_seen != g_transfer_failures) {
+        g_transfer_failures_seen = g_transfer_failures;
+        memset(g_pwm_buffer_dirty[0], 0xFF, sizeof(g_pwm_buffer_dirty[0]));
+        g_pwm_buffer_update_required           = true;
+        g_scaling_registers_update_required[0] = true;
+    }
+#endif
     if (g_pwm_buffer_update_required) {
-        IS31FL3741_write_pwm_buffer(addr1, g_pwm_buffer[0]);
+        // if any of the transfers fail, send the registers left dirty next time
+        if (!IS31FL3741_write_pwm_buffer_dirty(addr1, g_pwm_buffer[0], g_pwm_buffer_dirty[0])) {
+            return;
+        }
     }
 
     g_pwm_buffer_update_required = false;
 }
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue) {
-    g_pwm_buffer[pled->driver][pled->r] = red;
-    g_pwm_buffer[pled->driver][pled->g] = green;
-    g_pwm_buffer[pled->driver][pled->b] = blue;
-
-    g_pwm_buffer_update_required = true;
+    IS31FL3741_set_pwm_register(pled->driver, pled->r, red);
+    IS31FL3741_set_pwm_register(pled->driver, pled->g, green);
+    IS31FL3741_set_pwm_register(pled->driver, pled->b, blue);
 }
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -102,6 +102,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif  // defined(__AVR__)
 #define I2C_TRANSMIT(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
 #define I2C_WRITE_REG(mode, data, size) i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT)
+#if defined(I2C_ASYNC)
+// render data is queued, and sent while the keyboard task carries on
+#    define I2C_RENDER(data) i2c_transmit_async((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT, oled_render_done, NULL)
+#    define I2C_RENDER_REG(mode, data, size) i2c_writeReg_async((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT, oled_render_done, NULL)
+#else  // defined(I2C_ASYNC)
+#    define I2C_RENDER(data) I2C_TRANSMIT(data)
+#    define I2C_RENDER_REG(mode, data, size) I2C_WRITE_REG(mode, data, size)
+#endif  // defined(I2C_ASYNC)
 
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 
@@ -131,6 +139,13 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#if defined(I2C_ASYNC)
+_Static_assert(OLED_BLOCK_SIZE + 1 <= I2C_ASYNC_TRANSFER_SIZE, "I2C_ASYNC_TRANSFER_SIZE is too small for OLED_BLOCK_SIZE");
+
+// counts the render transfers that failed in the background, only written by the i2c thread
+volatile uint8_t oled_render_failures      = 0;
+uint8_t          oled_render_failures_seen = 0;
+#endif
 
 // Internal variables to reduce math instructions
 
@@ -285,11 +300,28 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+#if defined(I2C_ASYNC)
+static void oled_render_done(i2c_status_t status, void *arg) {
+    if (status != I2C_STATUS_SUCCESS) {
+        oled_render_failures++;
+    }
+}
+#endif
+
 void oled_render(void) {
     if (!oled_initialized) {
         return;
     }
 
+#if defined(I2C_ASYNC)
+    // A queued block didn't make it, the display may be out of step with the buffer
+    if (oled_render_failures_seen != oled_render_failures) {
+        oled_render_failures_seen = oled_render_failures;
+        print("oled_render failed, rendering everything again\n");
+        oled_dirty = OLED_ALL_BLOCKS_MASK;
+    }
+#endif
+
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
     if (!oled_dirty || oled_scrolling) {
@@ -311,14 +343,14 @@ void oled_render(void) {
     }
 
     // Send column & page position
-    if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+    if (I2C_RENDER(display_start) != I2C_STATUS_SUCCESS) {
         print("oled_render offset command failed\n");
         return;
     }
 
     if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
         // Send render data chunk as is
-        if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        if (I2C_RENDER_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
             print("oled_render data failed\n");
             return;
         }
@@ -334,7 +366,7 @@ void oled_render(void) {
         }
 
         // Send render data chunk after rotating
-        if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        if (I2C_RENDER_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
             print("oled_render90 data failed\n");
             return;
         }
@@ -755,6 +787,10 @@ void oled_task(void) {
 
     // Smart render system, no need to check for dirty
     oled_render();
+    // One block is sent per call, the rest go out in the next ones
+    if (oled_dirty && !oled_scrolling) {
+        keyboard_task_busy();
+    }
 
     // Display timeout check
 #if OLED_TIMEOUT > 0
@@ -33,6 +33,14 @@ void soft_serial_target_init(void);
 #define TRANSACTION_TYPE_ERROR 0x4
 int soft_serial_transaction(int sstd_index);
 
+#ifdef SERIAL_USART_ASYNC
+// initiator background transaction, returns false if one is still running
+bool soft_serial_transaction_post(int sstd_index);
+// initiator background result, TRANSACTION_PENDING while it runs unless asked to wait
+#    define TRANSACTION_PENDING 0x10
+int soft_serial_transaction_poll(bool wait);
+#endif
+
 // target status
 // *SSTD_t.status has
 //   initiator:
@@ -1,6 +1,9 @@
 #include "quantum.h"
 
 #ifndef MATRIX_IO_DELAY_DEFAULT
+#    ifdef MATRIX_SETTLE_CALIBRATION
+#        error "MATRIX_SETTLE_CALIBRATION provides matrix_output_unselect_delay(), it can't be combined with this one"
+#    endif
 /* In tmk_core/common/wait.h, the implementation for PROTOCOL_CHIBIOS
  * calls 'chThdSleepMicroseconds(1)' when 'wait_us(0)'.
  * However, 'wait_us(0)' should do nothing. */
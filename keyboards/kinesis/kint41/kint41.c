@@ -38,6 +38,10 @@ static void delay_inline(const uint32_t cycles) {
   }
 }
 
+#ifdef MATRIX_SETTLE_CALIBRATION
+#    error "MATRIX_SETTLE_CALIBRATION provides matrix_output_unselect_delay(), it can't be combined with this one"
+#endif
+
 void matrix_output_unselect_delay(void) {
   // Use the cycle counter to do precise timing in microseconds. The ChibiOS
   // thread sleep functions only allow sleep durations starting at 1 tick, which
@@ -27,6 +27,9 @@ void housekeeping_task_kb(void)
 }
 
 #if defined(BUSY_WAIT)
+#    ifdef MATRIX_SETTLE_CALIBRATION
+#        error "MATRIX_SETTLE_CALIBRATION provides matrix_output_unselect_delay(), it can't be combined with this one"
+#    endif
 void matrix_output_unselect_delay(void) {
     for (int32_t i = 0; i < BUSY_WAIT_INSTRUCTIONS; i++) {
         __asm__ volatile("nop" ::: "memory");
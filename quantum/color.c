@@ -18,46 +18,26 @@
 #include "led_tables.h"
 #include "progmem.h"
 
-RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
-    RGB      rgb;
-    uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
+// Fixed-point conversion once the value has been through the curve
+static inline RGB hsv_to_rgb_fixed(uint8_t h, uint8_t s, uint8_t v) {
+    RGB     rgb;
+    uint8_t region, remainder, p, q, t;
 
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
+    if (s == 0) {
+        rgb.r = v;
+        rgb.g = v;
+        rgb.b = v;
         return rgb;
     }
 
-    h = hsv.h;
-    s = hsv.s;
-#ifdef USE_CIE1931_CURVE
-    if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
-    }
-#else
-    v = hsv.v;
-#endif
-
     region    = h * 6 / 255;
     remainder = (h * 2 - region * 85) * 3;
 
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    // s * (255 - remainder) is the same as s * 255 - s * remainder, which saves a multiply
+    uint16_t sr = s * remainder;
+    p           = (v * (255 - s)) >> 8;
+    q           = (v * (255 - (sr >> 8))) >> 8;
+    t           = (v * (255 - ((s * 255 - sr) >> 8))) >> 8;
 
     switch (region) {
         case 6:
@@ -96,6 +76,16 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     return rgb;
 }
 
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+    uint8_t v = hsv.v;
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
+    }
+#endif
+    return hsv_to_rgb_fixed(hsv.h, hsv.s, v);
+}
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
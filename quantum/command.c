@@ -47,6 +47,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "audio.h"
 #endif /* AUDIO_ENABLE */
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_LINK_STATS_ENABLE)
+#    include "transactions.h"
+#endif
+
 static bool command_common(uint8_t code);
 static void command_common_help(void);
 static void print_version(void);
@@ -206,6 +210,11 @@ static void print_status(void) {
     print_val_hex8(keymap_config.nkro);
 #endif
     print_val_hex32(timer_read32());
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_LINK_STATS_ENABLE)
+    if (is_keyboard_master()) {
+        split_link_stats_print();
+    }
+#endif
     return;
 }
 
@@ -41,4 +41,14 @@ __attribute__((weak)) void crc_init(void);
  * \param[in] data_len Number of bytes in the \a data buffer.
  * \return             The calculated crc value.
  */
-__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
\ No newline at end of file
+__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
+
+/**
+ * Generate CRC16 value from given data.
+ * CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xffff.
+ *
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The calculated crc value.
+ */
+__attribute__((weak)) uint16_t crc16(const void *data, size_t data_len);
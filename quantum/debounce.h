@@ -1,11 +1,61 @@
 #pragma once
 
+#include "debug.h"
+
+#if (MATRIX_ROWS <= 8)
+typedef uint8_t debounce_rows_t;
+#elif (MATRIX_ROWS <= 16)
+typedef uint16_t debounce_rows_t;
+#elif (MATRIX_ROWS <= 32)
+typedef uint32_t debounce_rows_t;
+#else
+#    error "MATRIX_ROWS: invalid value"
+#endif
+
+#define DEBOUNCE_ROW_SHIFTER ((debounce_rows_t)1)
+#define DEBOUNCE_ALL_ROWS ((debounce_rows_t)~0)
+
+// Most rows the debounce algorithms are given, used to size their state at compile time
+#ifndef DEBOUNCE_MAX_ROWS
+#    ifdef SPLIT_KEYBOARD
+// each half only debounces its own rows
+#        define DEBOUNCE_MAX_ROWS (MATRIX_ROWS / 2)
+#    else
+#        define DEBOUNCE_MAX_ROWS MATRIX_ROWS
+#    endif
+#endif
+#if DEBOUNCE_MAX_ROWS > MATRIX_ROWS
+#    error "DEBOUNCE_MAX_ROWS can't be more than MATRIX_ROWS"
+#endif
+
+// Rows past DEBOUNCE_MAX_ROWS have no state to debounce them with, so they are passed through
+// raw instead of being dropped. Returns the number of rows left to debounce.
+static inline uint8_t debounce_clamp_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    static bool reported = false;
+
+    if (num_rows <= DEBOUNCE_MAX_ROWS) {
+        return num_rows;
+    }
+    if (!reported) {
+        dprintf("debounce: %u rows, DEBOUNCE_MAX_ROWS is %u, the rest are not debounced\n", num_rows, DEBOUNCE_MAX_ROWS);
+        reported = true;
+    }
+    for (uint8_t row = DEBOUNCE_MAX_ROWS; row < num_rows; row++) {
+        cooked[row] = raw[row];
+    }
+    return DEBOUNCE_MAX_ROWS;
+}
+
 // raw is the current key state
 // on entry cooked is the previous debounced state
 // on exit cooked is the current debounced state
 // changed is true if raw has changed since the last call
 void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
 
+// same as debounce(), but only the rows set in dirty_rows have changed in raw since the last call
+// rows that are neither dirty nor still debouncing are not touched
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows);
+
 bool debounce_active(void);
 
 void debounce_init(uint8_t num_rows);
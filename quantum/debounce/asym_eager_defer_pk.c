@@ -25,13 +25,8 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #include "matrix.h"
 #include "timer.h"
 #include "quantum.h"
-#include <stdlib.h>
-
-#ifdef PROTOCOL_CHIBIOS
-#    if CH_CFG_USE_MEMCORE == FALSE
-#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
-#    endif
-#endif
+#include "debounce.h"
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -51,36 +46,32 @@ typedef struct {
 } debounce_counter_t;
 
 #if DEBOUNCE > 0
-static debounce_counter_t *debounce_counters;
+static debounce_counter_t debounce_counters[DEBOUNCE_MAX_ROWS * MATRIX_COLS];
 static fast_timer_t last_time;
-static bool counters_need_update;
-static bool matrix_need_update;
+static debounce_rows_t active_rows;   // rows with running counters
+static debounce_rows_t expired_rows;  // rows with key-down counters that expired since the last transfer
 
 #define DEBOUNCE_ELAPSED 0
 
 static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
-static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t rows);
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-    debounce_counters = malloc(num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
-    int i = 0;
-    for (uint8_t r = 0; r < num_rows; r++) {
-        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
-            debounce_counters[i++].time = DEBOUNCE_ELAPSED;
-        }
-    }
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    active_rows = 0;
+    expired_rows = 0;
 }
 
-void debounce_free(void) {
-    free(debounce_counters);
-    debounce_counters = NULL;
-}
+void debounce_free(void) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) { debounce_rows(raw, cooked, num_rows, changed ? DEBOUNCE_ALL_ROWS : 0); }
 
-void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    num_rows = debounce_clamp_rows(raw, cooked, num_rows);
     bool updated_last = false;
 
-    if (counters_need_update) {
+    if (active_rows) {
         fast_timer_t now = timer_read_fast();
         fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
 
@@ -95,22 +86,25 @@ void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         }
     }
 
-    if (changed || matrix_need_update) {
+    if (dirty_rows || expired_rows) {
         if (!updated_last) {
             last_time = timer_read_fast();
         }
 
-        transfer_matrix_values(raw, cooked, num_rows);
+        transfer_matrix_values(raw, cooked, num_rows, dirty_rows | expired_rows);
+        expired_rows = 0;
     }
 }
 
 static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
-    debounce_counter_t *debounce_pointer = debounce_counters;
-
-    counters_need_update = false;
-    matrix_need_update = false;
-
     for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (!(active_rows & row_mask)) {
+            continue;
+        }
+
+        active_rows &= ~row_mask;
+        debounce_counter_t *debounce_pointer = debounce_counters + row * MATRIX_COLS;
         for (uint8_t col = 0; col < MATRIX_COLS; col++) {
             matrix_row_t col_mask = (ROW_SHIFTER << col);
 
@@ -120,14 +114,14 @@ static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[],
 
                     if (debounce_pointer->pressed) {
                         // key-down: eager
-                        matrix_need_update = true;
+                        expired_rows |= row_mask;
                     } else {
                         // key-up: defer
                         cooked[row] = (cooked[row] & ~col_mask) | (raw[row] & col_mask);
                     }
                 } else {
                     debounce_pointer->time -= elapsed_time;
-                    counters_need_update = true;
+                    active_rows |= row_mask;
                 }
             }
             debounce_pointer++;
@@ -135,10 +129,14 @@ static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[],
     }
 }
 
-static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
-    debounce_counter_t *debounce_pointer = debounce_counters;
-
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t rows) {
     for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (!(rows & row_mask)) {
+            continue;
+        }
+
+        debounce_counter_t *debounce_pointer = debounce_counters + row * MATRIX_COLS;
         matrix_row_t delta = raw[row] ^ cooked[row];
         for (uint8_t col = 0; col < MATRIX_COLS; col++) {
             matrix_row_t col_mask = (ROW_SHIFTER << col);
@@ -147,7 +145,7 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
                 if (debounce_pointer->time == DEBOUNCE_ELAPSED) {
                     debounce_pointer->pressed = (raw[row] & col_mask);
                     debounce_pointer->time = DEBOUNCE;
-                    counters_need_update = true;
+                    active_rows |= row_mask;
 
                     if (debounce_pointer->pressed) {
                         // key-down: eager
@@ -16,6 +16,7 @@
 
 #include "matrix.h"
 #include "quantum.h"
+#include "debounce.h"
 #include <stdlib.h>
 
 void debounce_init(uint8_t num_rows) {}
@@ -26,6 +27,14 @@ void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
     }
 }
 
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    for (int i = 0; i < num_rows; i++) {
+        if (dirty_rows & (DEBOUNCE_ROW_SHIFTER << i)) {
+            cooked[i] = raw[i];
+        }
+    }
+}
+
 bool debounce_active(void) { return false; }
 
 void debounce_free(void) {}
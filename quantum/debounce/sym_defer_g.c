@@ -20,6 +20,7 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #include "matrix.h"
 #include "timer.h"
 #include "quantum.h"
+#include "debounce.h"
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
 #endif
@@ -27,20 +28,31 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #if DEBOUNCE > 0
 static bool debouncing = false;
 static fast_timer_t debouncing_time;
+static debounce_rows_t debouncing_rows;
 
-void debounce_init(uint8_t num_rows) {}
+void debounce_init(uint8_t num_rows) {
+    debouncing      = false;
+    debouncing_rows = 0;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) { debounce_rows(raw, cooked, num_rows, changed ? DEBOUNCE_ALL_ROWS : 0); }
 
-void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
-    if (changed) {
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    if (dirty_rows) {
         debouncing      = true;
         debouncing_time = timer_read_fast();
+        debouncing_rows |= dirty_rows;
     }
 
     if (debouncing && timer_elapsed_fast(debouncing_time) >= DEBOUNCE) {
+        // only the rows that changed since the last push can differ
         for (int i = 0; i < num_rows; i++) {
-            cooked[i] = raw[i];
+            if (debouncing_rows & (DEBOUNCE_ROW_SHIFTER << i)) {
+                cooked[i] = raw[i];
+            }
         }
-        debouncing = false;
+        debouncing      = false;
+        debouncing_rows = 0;
     }
 }
 
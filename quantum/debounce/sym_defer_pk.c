@@ -22,13 +22,8 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #include "matrix.h"
 #include "timer.h"
 #include "quantum.h"
-#include <stdlib.h>
-
-#ifdef PROTOCOL_CHIBIOS
-#    if CH_CFG_USE_MEMCORE == FALSE
-#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
-#    endif
-#endif
+#include "debounce.h"
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -45,35 +40,30 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 typedef uint8_t debounce_counter_t;
 
 #if DEBOUNCE > 0
-static debounce_counter_t *debounce_counters;
+static debounce_counter_t debounce_counters[DEBOUNCE_MAX_ROWS * MATRIX_COLS];
 static fast_timer_t        last_time;
-static bool                counters_need_update;
+static debounce_rows_t     active_rows;  // rows with running counters
 
 #define DEBOUNCE_ELAPSED 0
 
 static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
-static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows);
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-    debounce_counters = (debounce_counter_t *)malloc(num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
-    int i             = 0;
-    for (uint8_t r = 0; r < num_rows; r++) {
-        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
-            debounce_counters[i++] = DEBOUNCE_ELAPSED;
-        }
-    }
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    active_rows = 0;
 }
 
-void debounce_free(void) {
-    free(debounce_counters);
-    debounce_counters = NULL;
-}
+void debounce_free(void) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) { debounce_rows(raw, cooked, num_rows, changed ? DEBOUNCE_ALL_ROWS : 0); }
 
-void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    num_rows = debounce_clamp_rows(raw, cooked, num_rows);
     bool updated_last = false;
 
-    if (counters_need_update) {
+    if (active_rows) {
         fast_timer_t now = timer_read_fast();
         fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
 
@@ -88,19 +78,24 @@ void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         }
     }
 
-    if (changed) {
+    if (dirty_rows) {
         if (!updated_last) {
             last_time = timer_read_fast();
         }
 
-        start_debounce_counters(raw, cooked, num_rows);
+        start_debounce_counters(raw, cooked, num_rows, dirty_rows);
     }
 }
 
 static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
-    counters_need_update                 = false;
-    debounce_counter_t *debounce_pointer = debounce_counters;
     for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (!(active_rows & row_mask)) {
+            continue;
+        }
+
+        active_rows &= ~row_mask;
+        debounce_counter_t *debounce_pointer = debounce_counters + row * MATRIX_COLS;
         for (uint8_t col = 0; col < MATRIX_COLS; col++) {
             if (*debounce_pointer != DEBOUNCE_ELAPSED) {
                 if (*debounce_pointer <= elapsed_time) {
@@ -108,7 +103,7 @@ static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[],
                     cooked[row]       = (cooked[row] & ~(ROW_SHIFTER << col)) | (raw[row] & (ROW_SHIFTER << col));
                 } else {
                     *debounce_pointer -= elapsed_time;
-                    counters_need_update = true;
+                    active_rows |= row_mask;
                 }
             }
             debounce_pointer++;
@@ -116,21 +111,32 @@ static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[],
     }
 }
 
-static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
-    debounce_counter_t *debounce_pointer = debounce_counters;
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
     for (uint8_t row = 0; row < num_rows; row++) {
-        matrix_row_t delta = raw[row] ^ cooked[row];
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (!(dirty_rows & row_mask)) {
+            continue;
+        }
+
+        debounce_counter_t *debounce_pointer = debounce_counters + row * MATRIX_COLS;
+        matrix_row_t        delta            = raw[row] ^ cooked[row];
         for (uint8_t col = 0; col < MATRIX_COLS; col++) {
             if (delta & (ROW_SHIFTER << col)) {
                 if (*debounce_pointer == DEBOUNCE_ELAPSED) {
-                    *debounce_pointer    = DEBOUNCE;
-                    counters_need_update = true;
+                    *debounce_pointer = DEBOUNCE;
                 }
             } else {
                 *debounce_pointer = DEBOUNCE_ELAPSED;
             }
             debounce_pointer++;
         }
+
+        // only keys that differ from their debounced state have running counters
+        if (delta) {
+            active_rows |= row_mask;
+        } else {
+            active_rows &= ~row_mask;
+        }
     }
 }
 
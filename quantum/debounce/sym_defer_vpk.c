@@ -0,0 +1,189 @@
+/*
+Copyright 2017 Alex Ong<the.onga@gmail.com>
+Copyright 2020 Andrei Purdea<andrei@purdea.ro>
+Copyright 2021 Simon Arlott
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm with vertical counters, behaves the same as sym_defer_pk.
+The counters are stored bit-sliced: bit N of the counters of every key in a row is kept
+in one matrix_row_t, so a whole row of counters is updated with a few word-wide logic
+operations instead of a loop over each column.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include "debounce.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+// Number of bit-planes needed to hold a counter value of DEBOUNCE
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_BITS 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_BITS 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_BITS 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_BITS 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_BITS 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_BITS 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_BITS 7
+#    else
+#        define DEBOUNCE_BITS 8
+#    endif
+
+#    define ROW_ALL ((matrix_row_t)~0)
+
+// debounce_counters[bit][row]: a key is debouncing when any of its bits is set
+static matrix_row_t debounce_counters[DEBOUNCE_BITS][DEBOUNCE_MAX_ROWS];
+static fast_timer_t    last_time;
+static debounce_rows_t active_rows;  // rows with running counters
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    active_rows = 0;
+}
+
+void debounce_free(void) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) { debounce_rows(raw, cooked, num_rows, changed ? DEBOUNCE_ALL_ROWS : 0); }
+
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    num_rows = debounce_clamp_rows(raw, cooked, num_rows);
+    bool updated_last = false;
+
+    if (active_rows) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (dirty_rows) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows, dirty_rows);
+    }
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (!(active_rows & row_mask)) {
+            continue;
+        }
+
+        matrix_row_t active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            active |= debounce_counters[bit][row];
+        }
+
+        // Subtract elapsed_time from all active counters of the row at once, one bit-plane at a time
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            matrix_row_t counter  = debounce_counters[bit][row];
+            matrix_row_t subtract = (elapsed_time & (1 << bit)) ? ROW_ALL : 0;
+
+            debounce_counters[bit][row] = (counter ^ subtract ^ borrow) & active;
+            borrow                      = (~counter & (subtract | borrow)) | (subtract & borrow);
+            remaining |= debounce_counters[bit][row];
+        }
+        if (elapsed_time >> DEBOUNCE_BITS) {
+            // more time has passed than any counter can hold
+            borrow = ROW_ALL;
+        }
+
+        // Counters that reached zero or wrapped around have expired
+        matrix_row_t expired = active & (borrow | ~remaining);
+        if (expired) {
+            for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+                debounce_counters[bit][row] &= ~expired;
+            }
+            cooked[row] = (cooked[row] & ~expired) | (raw[row] & expired);
+        }
+        if (!(active & ~expired)) {
+            active_rows &= ~row_mask;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (!(dirty_rows & row_mask)) {
+            continue;
+        }
+
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = 0;
+
+        // Stop the counters of keys that went back to their debounced state
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            debounce_counters[bit][row] &= delta;
+            active |= debounce_counters[bit][row];
+        }
+
+        // Start the counters of changed keys that aren't debouncing yet
+        matrix_row_t start = delta & ~active;
+        if (start) {
+            for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+                if (DEBOUNCE & (1 << bit)) {
+                    debounce_counters[bit][row] |= start;
+                }
+            }
+        }
+
+        // only keys that differ from their debounced state have running counters
+        if (delta) {
+            active_rows |= row_mask;
+        } else {
+            active_rows &= ~row_mask;
+        }
+    }
+}
+
+bool debounce_active(void) { return true; }
+#else
+#    include "none.c"
+#endif
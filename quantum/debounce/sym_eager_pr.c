@@ -22,13 +22,8 @@ No further inputs are accepted until DEBOUNCE milliseconds have occurred.
 #include "matrix.h"
 #include "timer.h"
 #include "quantum.h"
-#include <stdlib.h>
-
-#ifdef PROTOCOL_CHIBIOS
-#    if CH_CFG_USE_MEMCORE == FALSE
-#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
-#    endif
-#endif
+#include "debounce.h"
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -43,34 +38,32 @@ No further inputs are accepted until DEBOUNCE milliseconds have occurred.
 typedef uint8_t debounce_counter_t;
 
 #if DEBOUNCE > 0
-static bool matrix_need_update;
-
-static debounce_counter_t *debounce_counters;
+static debounce_counter_t debounce_counters[DEBOUNCE_MAX_ROWS];
 static fast_timer_t        last_time;
-static bool                counters_need_update;
+static debounce_rows_t     active_rows;   // rows with running counters
+static debounce_rows_t     expired_rows;  // rows with counters that expired since the last transfer
 
 #define DEBOUNCE_ELAPSED 0
 
 static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time);
-static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t rows);
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-    debounce_counters = (debounce_counter_t *)malloc(num_rows * sizeof(debounce_counter_t));
-    for (uint8_t r = 0; r < num_rows; r++) {
-        debounce_counters[r] = DEBOUNCE_ELAPSED;
-    }
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    active_rows  = 0;
+    expired_rows = 0;
 }
 
-void debounce_free(void) {
-    free(debounce_counters);
-    debounce_counters = NULL;
-}
+void debounce_free(void) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) { debounce_rows(raw, cooked, num_rows, changed ? DEBOUNCE_ALL_ROWS : 0); }
 
-void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) {
+    num_rows = debounce_clamp_rows(raw, cooked, num_rows);
     bool updated_last = false;
 
-    if (counters_need_update) {
+    if (active_rows) {
         fast_timer_t now = timer_read_fast();
         fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
 
@@ -85,28 +78,28 @@ void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         }
     }
 
-    if (changed || matrix_need_update) {
+    if (dirty_rows || expired_rows) {
         if (!updated_last) {
             last_time = timer_read_fast();
         }
 
-        transfer_matrix_values(raw, cooked, num_rows);
+        transfer_matrix_values(raw, cooked, num_rows, dirty_rows | expired_rows);
+        expired_rows = 0;
     }
 }
 
 // If the current time is > debounce counter, set the counter to enable input.
 static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
-    counters_need_update                 = false;
-    matrix_need_update                   = false;
     debounce_counter_t *debounce_pointer = debounce_counters;
     for (uint8_t row = 0; row < num_rows; row++) {
-        if (*debounce_pointer != DEBOUNCE_ELAPSED) {
+        debounce_rows_t row_mask = DEBOUNCE_ROW_SHIFTER << row;
+        if (active_rows & row_mask) {
             if (*debounce_pointer <= elapsed_time) {
                 *debounce_pointer = DEBOUNCE_ELAPSED;
-                matrix_need_update = true;
+                active_rows &= ~row_mask;
+                expired_rows |= row_mask;
             } else {
                 *debounce_pointer -= elapsed_time;
-                counters_need_update = true;
             }
         }
         debounce_pointer++;
@@ -114,18 +107,19 @@ static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
 }
 
 // upload from raw_matrix to final matrix;
-static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t rows) {
     debounce_counter_t *debounce_pointer = debounce_counters;
     for (uint8_t row = 0; row < num_rows; row++) {
-        matrix_row_t existing_row = cooked[row];
-        matrix_row_t raw_row      = raw[row];
+        debounce_rows_t row_mask     = DEBOUNCE_ROW_SHIFTER << row;
+        matrix_row_t    existing_row = cooked[row];
+        matrix_row_t    raw_row      = raw[row];
 
         // determine new value basd on debounce pointer + raw value
-        if (existing_row != raw_row) {
+        if ((rows & row_mask) && existing_row != raw_row) {
             if (*debounce_pointer == DEBOUNCE_ELAPSED) {
-                *debounce_pointer    = DEBOUNCE;
-                cooked[row]          = raw_row;
-                counters_need_update = true;
+                *debounce_pointer = DEBOUNCE;
+                cooked[row]       = raw_row;
+                active_rows |= row_mask;
             }
         }
         debounce_pointer++;
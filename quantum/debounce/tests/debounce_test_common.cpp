@@ -60,6 +60,7 @@ void DebounceTest::runEventsInternal() {
     debounce_init(MATRIX_ROWS);
     set_time(time_offset_);
     std::fill(std::begin(input_matrix_), std::end(input_matrix_), 0);
+    std::fill(std::begin(raw_matrix_), std::end(raw_matrix_), 0);
     std::fill(std::begin(output_matrix_), std::end(output_matrix_), 0);
 
     for (auto &event : events_) {
@@ -127,10 +128,20 @@ void DebounceTest::runEventsInternal() {
 }
 
 void DebounceTest::runDebounce(bool changed) {
+    debounce_rows_t dirty_rows = 0;
+
+    /* Only report the rows that really changed, like matrix_scan() does */
+    for (int row = 0; row < MATRIX_ROWS; row++) {
+        if (input_matrix_[row] != raw_matrix_[row]) {
+            dirty_rows |= DEBOUNCE_ROW_SHIFTER << row;
+        }
+    }
+    ASSERT_EQ(changed, dirty_rows != 0) << "Test reports a change without changing the input matrix at " << strTime();
+
     std::copy(std::begin(input_matrix_), std::end(input_matrix_), std::begin(raw_matrix_));
     std::copy(std::begin(output_matrix_), std::end(output_matrix_), std::begin(cooked_matrix_));
 
-    debounce(raw_matrix_, cooked_matrix_, MATRIX_ROWS, changed);
+    debounce_rows(raw_matrix_, cooked_matrix_, MATRIX_ROWS, dirty_rows);
 
     if (!std::equal(std::begin(input_matrix_), std::end(input_matrix_), std::begin(raw_matrix_))) {
         FAIL() << "Fatal error: debounce() modified raw matrix at " << strTime()
@@ -1,5 +1,6 @@
 #pragma once
 
+#ifdef LED_MATRIX_POLAR_ENABLED
 typedef uint8_t (*dx_dy_dist_f)(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uint8_t time);
 
 bool effect_runner_dx_dy_dist(effect_params_t* params, dx_dy_dist_f effect_func) {
@@ -8,10 +9,10 @@ bool effect_runner_dx_dy_dist(effect_params_t* params, dx_dy_dist_f effect_func)
     uint8_t time = scale16by8(g_led_timer, led_matrix_eeconfig.speed / 2);
     for (uint8_t i = led_min; i < led_max; i++) {
         LED_MATRIX_TEST_LED_FLAGS();
-        int16_t dx   = g_led_config.point[i].x - k_led_matrix_center.x;
-        int16_t dy   = g_led_config.point[i].y - k_led_matrix_center.y;
-        uint8_t dist = sqrt16(dx * dx + dy * dy);
-        led_matrix_set_value(i, effect_func(led_matrix_eeconfig.val, dx, dy, dist, time));
+        int16_t dx = g_led_config.point[i].x - k_led_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_led_matrix_center.y;
+        led_matrix_set_value(i, effect_func(led_matrix_eeconfig.val, dx, dy, g_led_polar[i].dist, time));
     }
     return led_max < DRIVER_LED_TOTAL;
 }
+#endif  // LED_MATRIX_POLAR_ENABLED
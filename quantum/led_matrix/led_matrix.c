@@ -98,6 +98,9 @@ const led_point_t k_led_matrix_center = LED_MATRIX_CENTER;
 // globals
 led_eeconfig_t led_matrix_eeconfig;  // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
 uint32_t       g_led_timer;
+#ifdef LED_MATRIX_POLAR_ENABLED
+led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif  // LED_MATRIX_POLAR_ENABLED
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif  // LED_MATRIX_FRAMEBUFFER_EFFECTS
@@ -120,6 +123,12 @@ static uint32_t led_anykey_timer;
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 static last_hit_t last_hit_buffer;
+#    if defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+// master: hits on this half the slave doesn't know about yet, oldest first
+static uint8_t  led_split_hits_count = 0;
+static uint8_t  led_split_hits_index[LED_HITS_TO_REMEMBER];
+static uint16_t led_split_hits_time[LED_HITS_TO_REMEMBER];
+#    endif
 #endif  // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // split led matrix
@@ -193,6 +202,64 @@ void led_matrix_set_value_all(uint8_t value) {
 #endif
 }
 
+#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+static void last_hit_buffer_add(const uint8_t led[], uint8_t led_count, uint16_t tick) {
+    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
+        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
+        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
+        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+    }
+
+    for (uint8_t i = 0; i < led_count; i++) {
+        uint8_t index                = last_hit_buffer.count;
+        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
+        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
+        last_hit_buffer.index[index] = led[i];
+        last_hit_buffer.tick[index]  = tick;
+        last_hit_buffer.count++;
+    }
+}
+
+#    if defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+static void led_split_hits_add(const uint8_t led[], uint8_t led_count) {
+    for (uint8_t i = 0; i < led_count; i++) {
+        if (led_split_hits_count == LED_HITS_TO_REMEMBER) {
+            // The oldest hit would be forgotten by the time it's sent anyway
+            memmove(&led_split_hits_index[0], &led_split_hits_index[1], LED_HITS_TO_REMEMBER - 1);
+            memmove(&led_split_hits_time[0], &led_split_hits_time[1], (LED_HITS_TO_REMEMBER - 1) * 2);  // 16 bit
+            led_split_hits_count--;
+        }
+        led_split_hits_index[led_split_hits_count] = led[i];
+        led_split_hits_time[led_split_hits_count]  = timer_read();
+        led_split_hits_count++;
+    }
+}
+
+uint8_t led_matrix_split_hits_take(led_split_hit_t *hits, uint8_t max) {
+    uint8_t count = led_split_hits_count < max ? led_split_hits_count : max;
+    for (uint8_t i = 0; i < count; i++) {
+        hits[i].index = led_split_hits_index[i];
+        hits[i].tick  = timer_elapsed(led_split_hits_time[i]);
+    }
+
+    led_split_hits_count -= count;
+    memmove(&led_split_hits_index[0], &led_split_hits_index[count], led_split_hits_count);
+    memmove(&led_split_hits_time[0], &led_split_hits_time[count], led_split_hits_count * 2);  // 16 bit
+    return count;
+}
+
+void led_matrix_split_hits_apply(const led_split_hit_t *hits, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (hits[i].index < DRIVER_LED_TOTAL) {
+            last_hit_buffer_add(&hits[i].index, 1, hits[i].tick);
+        }
+    }
+}
+#    endif  // defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+#endif      // LED_MATRIX_KEYREACTIVE_ENABLED
+
 void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef LED_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -214,22 +281,17 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+#    if defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+    bool local = is_keyboard_left() == (row < MATRIX_ROWS / 2);
+    if (!is_keyboard_master() && !local) {
+        // The master sends the slave the hits on its half
+        led_count = 0;
+    } else if (is_keyboard_master() && local) {
+        led_split_hits_add(led, led_count);
     }
+#    endif  // defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
 
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    last_hit_buffer_add(led, led_count, 0);
 #endif  // LED_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(LED_MATRIX_FRAMEBUFFER_EFFECTS) && !defined(DISABLE_LED_MATRIX_TYPING_HEATMAP)
@@ -395,6 +457,10 @@ void led_matrix_task(void) {
             led_task_sync();
             break;
     }
+    // A frame in progress carries on in the next call
+    if (led_task_state != SYNCING) {
+        keyboard_task_busy();
+    }
 }
 
 void led_matrix_indicators(void) {
@@ -428,8 +494,24 @@ __attribute__((weak)) void led_matrix_indicators_advanced_kb(uint8_t led_min, ui
 
 __attribute__((weak)) void led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
 
+#ifdef LED_MATRIX_POLAR_ENABLED
+static void led_matrix_init_polar(void) {
+    // The effects only need these relative to the center, which doesn't move,
+    // so they're not worked out again for every LED on every frame.
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_led_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_led_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif  // LED_MATRIX_POLAR_ENABLED
+
 void led_matrix_init(void) {
     led_matrix_driver.init();
+#ifdef LED_MATRIX_POLAR_ENABLED
+    led_matrix_init_polar();
+#endif  // LED_MATRIX_POLAR_ENABLED
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -101,6 +101,16 @@ void led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void led_matrix_init(void);
 
+#if defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+#    ifndef LED_MATRIX_KEYREACTIVE_ENABLED
+#        error "LED_MATRIX_SPLIT_HITS needs LED_MATRIX_KEYPRESSES or LED_MATRIX_KEYRELEASES"
+#    endif
+// master: take up to max hits on this half that the slave doesn't know about yet
+uint8_t led_matrix_split_hits_take(led_split_hit_t *hits, uint8_t max);
+// slave: add the hits sent by the master
+void led_matrix_split_hits_apply(const led_split_hit_t *hits, uint8_t count);
+#endif
+
 void        led_matrix_set_suspend_state(bool state);
 bool        led_matrix_get_suspend_state(void);
 void        led_matrix_toggle(void);
@@ -152,6 +162,9 @@ extern led_eeconfig_t led_matrix_eeconfig;
 
 extern uint32_t     g_led_timer;
 extern led_config_t g_led_config;
+#ifdef LED_MATRIX_POLAR_ENABLED
+extern led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
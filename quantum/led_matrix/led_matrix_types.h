@@ -33,6 +33,11 @@
 #    define LED_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+// The effects using the LED positions relative to the center, and custom ones that might
+#if !defined(DISABLE_LED_MATRIX_CYCLE_OUT_IN) || !defined(DISABLE_LED_MATRIX_BAND_PINWHEEL) || !defined(DISABLE_LED_MATRIX_BAND_SPIRAL) || defined(LED_MATRIX_CUSTOM_KB) || defined(LED_MATRIX_CUSTOM_USER)
+#    define LED_MATRIX_POLAR_ENABLED
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -46,7 +51,15 @@ typedef struct PACKED {
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
 } last_hit_t;
-#endif  // LED_MATRIX_KEYREACTIVE_ENABLED
+
+#    if defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+// A hit on the master's half, as sent to the slave
+typedef struct PACKED {
+    uint8_t  index;
+    uint16_t tick;
+} led_split_hit_t;
+#    endif  // defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+#endif      // LED_MATRIX_KEYREACTIVE_ENABLED
 
 typedef enum led_task_states { STARTING, RENDERING, FLUSHING, SYNCING } led_task_states;
 
@@ -63,6 +76,12 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+// Where an LED is relative to the center, worked out once by led_matrix_init()
+typedef struct PACKED {
+    uint8_t dist;
+    uint8_t angle;
+} led_polar_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
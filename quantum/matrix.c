@@ -34,6 +34,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define ROWS_PER_HAND (MATRIX_ROWS)
 #endif
 
+_Static_assert(ROWS_PER_HAND <= DEBOUNCE_MAX_ROWS, "DEBOUNCE_MAX_ROWS is too small to debounce every row");
+
 #ifdef DIRECT_PINS_RIGHT
 #    define SPLIT_MUTABLE
 #else
@@ -128,6 +130,38 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#    ifdef MATRIX_IDLE_SLEEP
+static bool matrix_idle_init(void) {
+    bool wakeable = true;
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            pin_t pin = direct_pins[row][col];
+            if (pin != NO_PIN) {
+                wakeable &= suspend_wakeup_pin_enable(pin);
+            }
+        }
+    }
+    return wakeable;
+}
+
+static bool matrix_idle_arm(void) {
+    bool released = true;
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            pin_t pin = direct_pins[row][col];
+            if (pin != NO_PIN) {
+                released &= readPin(pin);
+            }
+        }
+    }
+    return released;
+}
+
+static void matrix_idle_disarm(void) {}
+#    endif
+
 #elif defined(DIODE_DIRECTION)
 #    if defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
 #        if (DIODE_DIRECTION == COL2ROW)
@@ -163,14 +197,87 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
-__attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
+#            if defined(readPort) && defined(getPinPort)
+#                define MATRIX_READ_COLS_BY_PORT
+
+// Cols wired to consecutive bits of the same port, in order, are gathered with one shift and mask
+typedef struct {
+    uint8_t      port;      // index into col_ports
+    uint8_t      port_bit;  // port bit of the first col
+    uint8_t      col;       // first col
+    uint8_t      width;     // number of cols
+    matrix_row_t mask;      // one bit per col, starting at bit 0
+} col_run_t;
+
+static pin_t     col_ports[MATRIX_COLS];  // a pin of each port the cols are on
+static uint8_t   col_port_count;
+static col_run_t col_runs[MATRIX_COLS];
+static uint8_t   col_run_count;
+static bool      col_ports_shared;  // otherwise reading whole ports saves nothing
+
+static void init_col_ports(void) {
+    uint8_t pin_count = 0;
+
+    col_port_count = 0;
+    col_run_count  = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            continue;
+        }
+        pin_count++;
+
+        uint8_t port = 0;
+        while (port < col_port_count && getPinPort(col_ports[port]) != getPinPort(pin)) {
+            port++;
+        }
+        if (port == col_port_count) {
+            col_ports[col_port_count++] = pin;
+        }
+
+        col_run_t *run = col_run_count ? &col_runs[col_run_count - 1] : NULL;
+        if (run && run->port == port && run->col + run->width == col && run->port_bit + run->width == getPinPortBit(pin)) {
+            run->width++;
+            run->mask = (run->mask << 1) | 1;
+        } else {
+            run           = &col_runs[col_run_count++];
+            run->port     = port;
+            run->port_bit = getPinPortBit(pin);
+            run->col      = col;
+            run->width    = 1;
+            run->mask     = 1;
+        }
+    }
+    col_ports_shared = col_port_count < pin_count;
+}
+
+static matrix_row_t read_cols_by_port(void) {
+    port_data_t  port_state[MATRIX_COLS];
+    matrix_row_t current_row_value = 0;
+
+    for (uint8_t port = 0; port < col_port_count; port++) {
+        port_state[port] = readPort(col_ports[port]);
+    }
+
+    for (uint8_t i = 0; i < col_run_count; i++) {
+        const col_run_t *run = &col_runs[i];
+        // Pin LO means the key is pressed
+        current_row_value |= (~(matrix_row_t)(port_state[run->port] >> run->port_bit) & run->mask) << run->col;
+    }
+
+    return current_row_value;
+}
+#            endif
+
+static matrix_row_t read_cols(void) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
 
-    if (!select_row(current_row)) {  // Select row
-        return;                      // skip NO_PIN row
+#            ifdef MATRIX_READ_COLS_BY_PORT
+    if (col_ports_shared) {
+        return read_cols_by_port();
     }
-    matrix_output_select_delay();
+#            endif
 
     // For each col...
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++) {
@@ -180,6 +287,17 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         current_row_value |= pin_state ? 0 : (MATRIX_ROW_SHIFTER << col_index);
     }
 
+    return current_row_value;
+}
+
+__attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
+    if (!select_row(current_row)) {  // Select row
+        return;                      // skip NO_PIN row
+    }
+    matrix_output_select_delay();
+
+    matrix_row_t current_row_value = read_cols();
+
     // Unselect row
     unselect_row(current_row);
     matrix_output_unselect_delay(current_row, current_row_value != 0);  // wait for all Col signals to go HIGH
@@ -188,6 +306,47 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            ifdef MATRIX_SETTLE_CALIBRATION
+#                define MATRIX_SETTLE_LINES ROWS_PER_HAND
+
+static bool inputs_released(void) { return read_cols() == 0; }
+#            endif
+
+#            ifdef MATRIX_IDLE_SLEEP
+static bool matrix_idle_init(void) {
+    bool wakeable = true;
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (col_pins[col] != NO_PIN) {
+            wakeable &= suspend_wakeup_pin_enable(col_pins[col]);
+        }
+    }
+    return wakeable;
+}
+
+// Select every row so that any key press pulls its col low
+static bool matrix_idle_arm(void) {
+    bool released = true;
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (col_pins[col] != NO_PIN) {
+            released &= readPin(col_pins[col]);
+        }
+    }
+    return released;
+}
+
+static void matrix_idle_disarm(void) {
+    unselect_rows();
+    matrix_io_delay();  // wait for all Col signals to go HIGH, not a per-line settle time
+}
+#            endif
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -248,6 +407,54 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     matrix_output_unselect_delay(current_col, key_pressed);  // wait for all Row signals to go HIGH
 }
 
+#            ifdef MATRIX_SETTLE_CALIBRATION
+#                define MATRIX_SETTLE_LINES MATRIX_COLS
+
+static bool inputs_released(void) {
+    for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
+        if (readMatrixPin(row_pins[row_index]) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+#            endif
+
+#            ifdef MATRIX_IDLE_SLEEP
+static bool matrix_idle_init(void) {
+    bool wakeable = true;
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (row_pins[row] != NO_PIN) {
+            wakeable &= suspend_wakeup_pin_enable(row_pins[row]);
+        }
+    }
+    return wakeable;
+}
+
+// Select every col so that any key press pulls its row low
+static bool matrix_idle_arm(void) {
+    bool released = true;
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (row_pins[row] != NO_PIN) {
+            released &= readPin(row_pins[row]);
+        }
+    }
+    return released;
+}
+
+static void matrix_idle_disarm(void) {
+    unselect_cols();
+    matrix_io_delay();  // wait for all Row signals to go HIGH, not a per-line settle time
+}
+#            endif
+
 #        else
 #            error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
 #        endif
@@ -256,6 +463,93 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_SETTLE_LINES
+// The matrix_output_unselect_delay() below replaces the one a keyboard would tune itself
+#    ifdef MATRIX_IO_DELAY
+#        error "MATRIX_SETTLE_CALIBRATION measures the unselect delay, it can't be combined with MATRIX_IO_DELAY"
+#    endif
+#    ifndef MATRIX_SETTLE_MAX_POLLS
+#        define MATRIX_SETTLE_MAX_POLLS 200
+#    endif
+
+// Number of times to read the inputs after unselecting each line, or EECONFIG_MATRIX_SETTLE_DEFAULT
+static uint8_t settle_polls[EECONFIG_MATRIX_SETTLE_SIZE];
+// Reads each line needed for its inputs to recover since calibration started, plus one, or 0
+static uint8_t settle_measured[MATRIX_SETTLE_LINES];
+static bool    settle_calibrating;
+
+static void settle_init(void) {
+    if (!eeconfig_read_matrix_settle(settle_polls)) {
+        memset(settle_polls, EECONFIG_MATRIX_SETTLE_DEFAULT, sizeof(settle_polls));
+    }
+}
+
+void matrix_settle_calibrate_start(void) {
+    memset(settle_measured, 0, sizeof(settle_measured));
+    settle_calibrating = true;
+}
+
+void matrix_settle_calibrate_stop(void) {
+    settle_calibrating = false;
+
+    // Lines that had no key pressed keep their previous settle time
+    for (uint8_t line = 0; line < MATRIX_SETTLE_LINES; line++) {
+        if (settle_measured[line]) {
+            // double it, for margin against temperature and supply changes
+            uint16_t polls     = settle_measured[line] * 2;
+            settle_polls[line] = polls < MATRIX_SETTLE_MAX_POLLS ? polls : MATRIX_SETTLE_MAX_POLLS;
+        }
+    }
+    eeconfig_update_matrix_settle(settle_polls);
+}
+
+// Reading the inputs until they recover paces the wait the same during calibration and scanning
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {
+    if (settle_calibrating && key_pressed) {
+        uint8_t polls = 1;
+        while (!inputs_released() && polls < MATRIX_SETTLE_MAX_POLLS) {
+            polls++;
+        }
+        if (polls > settle_measured[line]) {
+            settle_measured[line] = polls;
+        }
+        matrix_io_delay();
+        return;
+    }
+
+    if (settle_polls[line] == EECONFIG_MATRIX_SETTLE_DEFAULT) {
+        matrix_io_delay();
+        return;
+    }
+    for (uint8_t i = 0; i < settle_polls[line]; i++) {
+        inputs_released();
+    }
+}
+#endif
+
+#if defined(MATRIX_IDLE_SLEEP) && (defined(DIRECT_PINS) || (defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)))
+#    define MATRIX_IDLE_PINS
+#endif
+
+#ifdef MATRIX_IDLE_PINS
+// whether a press on any input wakes the MCU
+static bool matrix_idle_wakeable = false;
+
+// Leave the outputs selected so that the first key press wakes the MCU rather than waiting for the next tick.
+// If an input can't wake it, the MCU doesn't sleep at all, rather than reading that key up to a tick late.
+void matrix_idle_sleep(void) {
+    if (!matrix_idle_wakeable || !matrix_is_idle()) {
+        return;
+    }
+
+    // a key pressed since the last scan would not trigger a wakeup
+    if (matrix_idle_arm()) {
+        suspend_idle(1);
+    }
+    matrix_idle_disarm();
+}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
@@ -290,6 +584,12 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_READ_COLS_BY_PORT
+    init_col_ports();
+#endif
+#ifdef MATRIX_SETTLE_LINES
+    settle_init();
+#endif
 
     // initialize matrix state: all keys off
     for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
@@ -304,6 +604,11 @@ void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     split_post_init();
 #endif
+
+#ifdef MATRIX_IDLE_PINS
+    // after the split transport, so that the wakeup pins skip any line it has taken
+    matrix_idle_wakeable = matrix_idle_init();
+#endif
 }
 
 #ifdef SPLIT_KEYBOARD
@@ -318,9 +623,13 @@ bool matrix_post_scan(void) {
 
             if (error_count > ERROR_DISCONNECT_COUNT) {
                 // reset other half if disconnected
+                memset(slave_matrix, 0, sizeof(slave_matrix));
+#    ifdef MATRIX_KEY_TIMESTAMPS
+                // the keys still held are released now
+                matrix_release_key_times(matrix + thatHand, thatHand, ROWS_PER_HAND);
+#    endif
                 for (int i = 0; i < ROWS_PER_HAND; ++i) {
                     matrix[thatHand + i] = 0;
-                    slave_matrix[i]      = 0;
                 }
 
                 changed = true;
@@ -328,6 +637,10 @@ bool matrix_post_scan(void) {
         } else {
             error_count = 0;
 
+#    ifdef MATRIX_KEY_TIMESTAMPS
+            // the other half only sends its debounced state, so use the time it was received
+            matrix_update_key_times(matrix + thatHand, slave_matrix, thatHand, ROWS_PER_HAND);
+#    endif
             for (int i = 0; i < ROWS_PER_HAND; ++i) {
                 if (matrix[thatHand + i] != slave_matrix[i]) {
                     matrix[thatHand + i] = slave_matrix[i];
@@ -362,14 +675,30 @@ uint8_t matrix_scan(void) {
     }
 #endif
 
-    bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
-    if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+    debounce_rows_t dirty_rows = 0;
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] != curr_matrix[row]) {
+            dirty_rows |= DEBOUNCE_ROW_SHIFTER << row;
+        }
+    }
+
+    bool changed = dirty_rows != 0;
+    if (changed) {
+#ifdef MATRIX_KEY_TIMESTAMPS
+#    ifdef SPLIT_KEYBOARD
+        matrix_update_key_times(raw_matrix, curr_matrix, thisHand, ROWS_PER_HAND);
+#    else
+        matrix_update_key_times(raw_matrix, curr_matrix, 0, ROWS_PER_HAND);
+#    endif
+#endif
+        memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+    }
 
 #ifdef SPLIT_KEYBOARD
-    debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    debounce_rows(raw_matrix, matrix + thisHand, ROWS_PER_HAND, dirty_rows);
     changed = (changed || matrix_post_scan());
 #else
-    debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    debounce_rows(raw_matrix, matrix, ROWS_PER_HAND, dirty_rows);
     matrix_scan_quantum();
 #endif
     return (uint8_t)changed;
@@ -54,6 +54,26 @@ bool matrix_is_on(uint8_t row, uint8_t col);
 matrix_row_t matrix_get_row(uint8_t row);
 /* print matrix for debug */
 void matrix_print(void);
+#ifdef MATRIX_KEY_TIMESTAMPS
+/* time (timer_read_fast(), truncated to 16 bits) of the last transition of a switch */
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col);
+/* record the current time for every switch that differs between prev and curr */
+void matrix_update_key_times(matrix_row_t prev[], matrix_row_t curr[], uint8_t row_offset, uint8_t num_rows);
+/* record the current time for every switch still on in rows, which are released without a scan */
+void matrix_release_key_times(matrix_row_t rows[], uint8_t row_offset, uint8_t num_rows);
+#endif
+#ifdef MATRIX_IDLE_SLEEP
+/* whether no switch is pressed or waiting to be released by debouncing */
+bool matrix_is_idle(void);
+/* if the matrix is idle, sleep until a switch changes or the next timer tick */
+void matrix_idle_sleep(void);
+#endif
+#ifdef MATRIX_SETTLE_CALIBRATION
+/* measure how long the inputs take to recover after unselecting each line with a key pressed */
+void matrix_settle_calibrate_start(void);
+/* stop measuring, and use and store the measured settle times */
+void matrix_settle_calibrate_stop(void);
+#endif
 /* delay between changing matrix pin state and reading values */
 void matrix_output_select_delay(void);
 void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "quantum.h"
 #include "matrix.h"
 #include "debounce.h"
@@ -45,6 +46,27 @@ inline matrix_row_t matrix_get_row(uint8_t row) {
 #endif
 }
 
+#ifdef MATRIX_IDLE_SLEEP
+bool matrix_is_idle(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (raw_matrix[row] || matrix[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Matrices that can't arm interrupts on their inputs only wake on the next timer tick
+__attribute__((weak)) void matrix_idle_sleep(void) {
+    if (matrix_is_idle()) {
+        suspend_idle(1);
+    }
+}
+#endif
+
+// Debounce algorithms that don't track rows (e.g. DEBOUNCE_TYPE = custom) handle every row on each change
+__attribute__((weak)) void debounce_rows(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, debounce_rows_t dirty_rows) { debounce(raw, cooked, num_rows, dirty_rows != 0); }
+
 // Deprecated.
 bool matrix_is_modified(void) {
     if (debounce_active()) return false;
@@ -110,8 +132,17 @@ __attribute__((weak)) void matrix_init(void) {
 }
 
 __attribute__((weak)) uint8_t matrix_scan(void) {
+#ifdef MATRIX_KEY_TIMESTAMPS
+    matrix_row_t prev_matrix[MATRIX_ROWS];
+    memcpy(prev_matrix, raw_matrix, sizeof(prev_matrix));
+#endif
+
     bool changed = matrix_scan_custom(raw_matrix);
 
+#ifdef MATRIX_KEY_TIMESTAMPS
+    if (changed) matrix_update_key_times(prev_matrix, raw_matrix, 0, MATRIX_ROWS);
+#endif
+
     debounce(raw_matrix, matrix, MATRIX_ROWS, changed);
 
     matrix_scan_quantum();
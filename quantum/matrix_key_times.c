@@ -0,0 +1,35 @@
+#include "matrix.h"
+#include "timer.h"
+
+// Built for every matrix, including fully custom ones (CUSTOM_MATRIX = yes)
+#ifdef MATRIX_KEY_TIMESTAMPS
+/* time of the last raw transition of each switch */
+static uint16_t matrix_key_time[MATRIX_ROWS][MATRIX_COLS];
+
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col) { return matrix_key_time[row][col]; }
+
+static void matrix_stamp_keys(const matrix_row_t keys[], uint8_t row_offset, uint8_t num_rows) {
+    const uint16_t now = (uint16_t)timer_read_fast();
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t row_keys = keys[row];
+        for (uint8_t col = 0; row_keys; col++, row_keys >>= 1) {
+            if (row_keys & 1) {
+                matrix_key_time[row_offset + row][col] = now;
+            }
+        }
+    }
+}
+
+// Debouncing only delays when the debounced state follows the raw state, so the time of
+// the last raw edge is the transition time for all debounce algorithms.
+void matrix_update_key_times(matrix_row_t prev[], matrix_row_t curr[], uint8_t row_offset, uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        const matrix_row_t changes = prev[row] ^ curr[row];
+        matrix_stamp_keys(&changes, row_offset + row, 1);
+    }
+}
+
+// e.g. the keys of a split half that disconnected
+void matrix_release_key_times(matrix_row_t rows[], uint8_t row_offset, uint8_t num_rows) { matrix_stamp_keys(rows, row_offset, num_rows); }
+#endif
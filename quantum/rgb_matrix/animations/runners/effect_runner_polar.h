@@ -0,0 +1,19 @@
+#pragma once
+
+#ifdef RGB_MATRIX_POLAR_ENABLED
+typedef HSV (*polar_f)(HSV hsv, uint8_t dist, uint8_t angle, uint8_t time);
+
+bool effect_runner_polar(effect_params_t* params, polar_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    rgb_hsv_batch_t batch = {.count = 0};
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_hsv_batch_set(&batch, i, effect_func(rgb_matrix_config.hsv, g_led_polar[i].dist, g_led_polar[i].angle, time));
+    }
+    rgb_hsv_batch_flush(&batch);
+    return led_max < DRIVER_LED_TOTAL;
+}
+#endif  // RGB_MATRIX_POLAR_ENABLED
@@ -1,5 +1,5 @@
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && !defined(DISABLE_RGB_MATRIX_TYPING_HEATMAP)
-RGB_MATRIX_EFFECT(TYPING_HEATMAP)
+RGB_MATRIX_EFFECT(TYPING_HEATMAP, RGB_EFFECT_FRAMEBUFFER)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS
@@ -7,61 +7,76 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        endif
 
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    uint8_t(*frame)[MATRIX_COLS] = rgb_matrix_framebuffer();
+    if (!frame) {
+        // Not started yet, it gets a cleared framebuffer when it does
+        return;
+    }
+
     uint8_t m_row = row - 1;
     uint8_t p_row = row + 1;
     uint8_t m_col = col - 1;
     uint8_t p_col = col + 1;
 
-    if (m_col < col) g_rgb_frame_buffer[row][m_col] = qadd8(g_rgb_frame_buffer[row][m_col], 16);
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-    if (p_col < MATRIX_COLS) g_rgb_frame_buffer[row][p_col] = qadd8(g_rgb_frame_buffer[row][p_col], 16);
+    if (m_col < col) frame[row][m_col] = qadd8(frame[row][m_col], 16);
+    frame[row][col] = qadd8(frame[row][col], 32);
+    if (p_col < MATRIX_COLS) frame[row][p_col] = qadd8(frame[row][p_col], 16);
 
     if (p_row < MATRIX_ROWS) {
-        if (m_col < col) g_rgb_frame_buffer[p_row][m_col] = qadd8(g_rgb_frame_buffer[p_row][m_col], 13);
-        g_rgb_frame_buffer[p_row][col] = qadd8(g_rgb_frame_buffer[p_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[p_row][p_col] = qadd8(g_rgb_frame_buffer[p_row][p_col], 13);
+        if (m_col < col) frame[p_row][m_col] = qadd8(frame[p_row][m_col], 13);
+        frame[p_row][col] = qadd8(frame[p_row][col], 16);
+        if (p_col < MATRIX_COLS) frame[p_row][p_col] = qadd8(frame[p_row][p_col], 13);
     }
 
     if (m_row < row) {
-        if (m_col < col) g_rgb_frame_buffer[m_row][m_col] = qadd8(g_rgb_frame_buffer[m_row][m_col], 13);
-        g_rgb_frame_buffer[m_row][col] = qadd8(g_rgb_frame_buffer[m_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[m_row][p_col] = qadd8(g_rgb_frame_buffer[m_row][p_col], 13);
+        if (m_col < col) frame[m_row][m_col] = qadd8(frame[m_row][m_col], 13);
+        frame[m_row][col] = qadd8(frame[m_row][col], 16);
+        if (p_col < MATRIX_COLS) frame[m_row][p_col] = qadd8(frame[m_row][p_col], 13);
     }
 }
 
-// A timer to track the last time we decremented all heatmap values.
+// A timer to track the last time we decremented the heatmap values.
 static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
+// How much to decrement the heatmap values by during this update.
+static uint8_t heatmap_decrease;
 
 bool TYPING_HEATMAP(effect_params_t* params) {
     // Modified version of RGB_MATRIX_USE_LIMITS to work off of matrix row / col size
+#        ifdef RGB_MATRIX_RENDER_BUDGET
+    uint8_t led_min = params->led_min;
+    uint8_t led_max = params->led_max;
+#        else
     uint8_t led_min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;
     uint8_t led_max = led_min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (led_max > sizeof(g_rgb_frame_buffer)) led_max = sizeof(g_rgb_frame_buffer);
+#        endif
+    if (led_max > MATRIX_ROWS * MATRIX_COLS) led_max = MATRIX_ROWS * MATRIX_COLS;
+
+    uint8_t(*frame)[MATRIX_COLS] = rgb_matrix_framebuffer();
+    if (!frame) {
+        return false;
+    }
 
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
-        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
     }
 
     // The heatmap animation might run in several iterations depending on
     // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
+    // timer when the animation starts. Every delay that has passed since the
+    // last decrease is made up for in one go.
     if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+        uint16_t steps = timer_elapsed(heatmap_decrease_timer) / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
 
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
-        }
+        heatmap_decrease = steps < UINT8_MAX ? steps : UINT8_MAX;
+        heatmap_decrease_timer += steps * RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
     }
 
     // Render heatmap & decrease
-    for (int i = led_min; i < led_max; i++) {
+    rgb_hsv_batch_t batch = {.count = 0};
+    for (uint8_t i = led_min; i < led_max; i++) {
         uint8_t row = i % MATRIX_ROWS;
         uint8_t col = i / MATRIX_ROWS;
-        uint8_t val = g_rgb_frame_buffer[row][col];
+        uint8_t val = frame[row][col];
 
         // set the pixel colour
         uint8_t led[LED_HITS_TO_REMEMBER];
@@ -69,17 +84,23 @@ bool TYPING_HEATMAP(effect_params_t* params) {
         for (uint8_t j = 0; j < led_count; ++j) {
             if (!HAS_ANY_FLAGS(g_led_config.flags[led[j]], params->flags)) continue;
 
+            if (val == 0) {
+                // Cold keys are dark, and still need setting in case an indicator was shown on them
+                rgb_matrix_set_color(led[j], 0, 0, 0);
+                continue;
+            }
+
             HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-            RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-            rgb_matrix_set_color(led[j], rgb.r, rgb.g, rgb.b);
+            rgb_hsv_batch_set(&batch, led[j], hsv);
         }
 
-        if (decrease_heatmap_values) {
-            g_rgb_frame_buffer[row][col] = qsub8(val, 1);
+        if (val) {
+            frame[row][col] = qsub8(val, heatmap_decrease);
         }
     }
+    rgb_hsv_batch_flush(&batch);
 
-    return led_max < sizeof(g_rgb_frame_buffer);
+    return led_max < MATRIX_ROWS * MATRIX_COLS;
 }
 
 #    endif  // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
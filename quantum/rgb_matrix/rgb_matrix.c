@@ -41,12 +41,43 @@ const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) { return hsv_to_rgb(hsv); }
 
+// Goes through rgb_matrix_hsv_to_rgb(), so that overriding that one is enough for the runners as well
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+}
+
+// Colours the runners have worked out, waiting to be converted and set
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH];
+    HSV     hsv[RGB_MATRIX_HSV_BATCH];
+} rgb_hsv_batch_t;
+
+static void rgb_hsv_batch_flush(rgb_hsv_batch_t *batch) {
+    RGB rgb[RGB_MATRIX_HSV_BATCH];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t n = 0; n < batch->count; n++) {
+        rgb_matrix_set_color(batch->index[n], rgb[n].r, rgb[n].g, rgb[n].b);
+    }
+    batch->count = 0;
+}
+
+static inline void rgb_hsv_batch_set(rgb_hsv_batch_t *batch, uint8_t index, HSV hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH) {
+        rgb_hsv_batch_flush(batch);
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
-#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_EFFECT(name, ...)
 #define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #include "rgb_matrix_effects.inc"
@@ -119,9 +150,9 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) { return hsv_to_rgb(hsv
 // globals
 rgb_config_t rgb_matrix_config;  // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
 uint32_t     g_rgb_timer;
-#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
-uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
-#endif  // RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#ifdef RGB_MATRIX_POLAR_ENABLED
+led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif  // RGB_MATRIX_POLAR_ENABLED
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -133,6 +164,21 @@ static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#    if !defined(DISABLE_RGB_MATRIX_TYPING_HEATMAP) || !defined(DISABLE_RGB_MATRIX_DIGITAL_RAIN)
+_Static_assert(RGB_MATRIX_FRAMEBUFFER_SIZE >= MATRIX_ROWS * MATRIX_COLS, "RGB_MATRIX_FRAMEBUFFER_SIZE is too small for the built-in framebuffer effects");
+#    endif
+static uint8_t rgb_framebuffer[RGB_MATRIX_FRAMEBUFFER_SIZE];
+static uint8_t rgb_framebuffer_owner = RGB_MATRIX_NONE;  // the effect the framebuffer was last cleared for
+#endif
+#ifdef RGB_MATRIX_RENDER_BUDGET
+static uint32_t rgb_render_cost = 0;  // average time it takes to render one LED, in 1/256 microseconds
+#endif
+#ifdef RGB_MATRIX_DEBUG_FPS
+static uint16_t rgb_fps_count = 0;
+static uint16_t rgb_fps_last  = 0;
+static uint32_t rgb_fps_timer = 0;
+#endif
 #if RGB_DISABLE_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif  // RGB_DISABLE_TIMEOUT > 0
@@ -141,11 +187,27 @@ static uint32_t rgb_anykey_timer;
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 static last_hit_t last_hit_buffer;
+#    if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+// master: hits on this half the slave doesn't know about yet, oldest first
+static uint8_t  rgb_split_hits_count = 0;
+static uint8_t  rgb_split_hits_index[LED_HITS_TO_REMEMBER];
+static uint16_t rgb_split_hits_time[LED_HITS_TO_REMEMBER];
+#    endif
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+#    ifdef RGB_MATRIX_SPLIT_STREAM
+// master: the colors of the other half, and which of them the slave needs
+static RGB      rgb_split_frame[DRIVER_LED_TOTAL];
+static uint8_t  rgb_split_dirty[(DRIVER_LED_TOTAL + 7) / 8];    // changed since the last flush
+static uint8_t  rgb_split_pending[(DRIVER_LED_TOTAL + 7) / 8];  // flushed, not taken yet
+static uint32_t rgb_split_refresh_timer;
+// slave: colors have been received since the last flush
+static bool rgb_split_received  = false;
+static bool rgb_split_suspended = false;
+#    endif
 #endif
 
 void eeconfig_read_rgb_matrix(void) { eeprom_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
@@ -187,8 +249,69 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 
 void rgb_matrix_update_pwm_buffers(void) { rgb_matrix_driver.flush(); }
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+static void rgb_split_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index < 0 || index >= DRIVER_LED_TOTAL) return;
+
+    RGB *led = &rgb_split_frame[index];
+    if (led->r != red || led->g != green || led->b != blue) {
+        led->r = red;
+        led->g = green;
+        led->b = blue;
+        rgb_split_dirty[index / 8] |= 1 << (index % 8);
+    }
+}
+
+static void rgb_split_flush(void) {
+    if (timer_elapsed32(rgb_split_refresh_timer) >= RGB_MATRIX_SPLIT_STREAM_REFRESH) {
+        rgb_split_refresh_timer = timer_read32();
+        memset(rgb_split_dirty, 0xFF, sizeof(rgb_split_dirty));
+    }
+
+    for (uint8_t i = 0; i < sizeof(rgb_split_pending); i++) {
+        rgb_split_pending[i] |= rgb_split_dirty[i];
+        rgb_split_dirty[i] = 0;
+    }
+}
+
+uint8_t rgb_matrix_split_stream_take(rgb_split_led_t *leds, uint8_t max) {
+    // Only the other half's LEDs
+    uint8_t first = is_keyboard_left() ? k_rgb_matrix_split[0] : 0;
+    uint8_t last  = is_keyboard_left() ? DRIVER_LED_TOTAL : k_rgb_matrix_split[0];
+    uint8_t count = 0;
+    for (uint8_t i = first; i < last && count < max; i++) {
+        uint8_t mask = 1 << (i % 8);
+        if (rgb_split_pending[i / 8] & mask) {
+            rgb_split_pending[i / 8] &= ~mask;
+            leds[count].index = i;
+            leds[count].r     = rgb_split_frame[i].r;
+            leds[count].g     = rgb_split_frame[i].g;
+            leds[count].b     = rgb_split_frame[i].b;
+            count++;
+        }
+    }
+    return count;
+}
+
+void rgb_matrix_split_stream_apply(const rgb_split_led_t *leds, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb_matrix_set_color(leds[i].index, leds[i].r, leds[i].g, leds[i].b);
+    }
+    if (count) {
+        rgb_split_received = true;
+    }
+}
+#endif
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#    ifdef RGB_MATRIX_SPLIT_STREAM
+    if (is_keyboard_master() && is_keyboard_left() == (index >= k_rgb_matrix_split[0])) {
+        // The other half's LED, it's sent to the slave
+        rgb_split_set_color(index, red, green, blue);
+        return;
+    }
+#    endif
     if (!is_keyboard_left() && index >= k_rgb_matrix_split[0])
         rgb_matrix_driver.set_color(index - k_rgb_matrix_split[0], red, green, blue);
     else if (is_keyboard_left() && index < k_rgb_matrix_split[0])
@@ -204,6 +327,64 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void last_hit_buffer_add(const uint8_t led[], uint8_t led_count, uint16_t tick) {
+    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
+        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
+        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
+        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+    }
+
+    for (uint8_t i = 0; i < led_count; i++) {
+        uint8_t index                = last_hit_buffer.count;
+        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
+        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
+        last_hit_buffer.index[index] = led[i];
+        last_hit_buffer.tick[index]  = tick;
+        last_hit_buffer.count++;
+    }
+}
+
+#    if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+static void rgb_split_hits_add(const uint8_t led[], uint8_t led_count) {
+    for (uint8_t i = 0; i < led_count; i++) {
+        if (rgb_split_hits_count == LED_HITS_TO_REMEMBER) {
+            // The oldest hit would be forgotten by the time it's sent anyway
+            memmove(&rgb_split_hits_index[0], &rgb_split_hits_index[1], LED_HITS_TO_REMEMBER - 1);
+            memmove(&rgb_split_hits_time[0], &rgb_split_hits_time[1], (LED_HITS_TO_REMEMBER - 1) * 2);  // 16 bit
+            rgb_split_hits_count--;
+        }
+        rgb_split_hits_index[rgb_split_hits_count] = led[i];
+        rgb_split_hits_time[rgb_split_hits_count]  = timer_read();
+        rgb_split_hits_count++;
+    }
+}
+
+uint8_t rgb_matrix_split_hits_take(rgb_split_hit_t *hits, uint8_t max) {
+    uint8_t count = rgb_split_hits_count < max ? rgb_split_hits_count : max;
+    for (uint8_t i = 0; i < count; i++) {
+        hits[i].index = rgb_split_hits_index[i];
+        hits[i].tick  = timer_elapsed(rgb_split_hits_time[i]);
+    }
+
+    rgb_split_hits_count -= count;
+    memmove(&rgb_split_hits_index[0], &rgb_split_hits_index[count], rgb_split_hits_count);
+    memmove(&rgb_split_hits_time[0], &rgb_split_hits_time[count], rgb_split_hits_count * 2);  // 16 bit
+    return count;
+}
+
+void rgb_matrix_split_hits_apply(const rgb_split_hit_t *hits, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (hits[i].index < DRIVER_LED_TOTAL) {
+            last_hit_buffer_add(&hits[i].index, 1, hits[i].tick);
+        }
+    }
+}
+#    endif  // defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+#endif      // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -225,22 +406,17 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+#    if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+    bool local = is_keyboard_left() == (row < MATRIX_ROWS / 2);
+    if (!is_keyboard_master() && !local) {
+        // The master sends the slave the hits on its half
+        led_count = 0;
+    } else if (is_keyboard_master() && local) {
+        rgb_split_hits_add(led, led_count);
     }
+#    endif  // defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
 
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    last_hit_buffer_add(led, led_count, 0);
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && !defined(DISABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -283,6 +459,37 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+typedef bool (*rgb_effect_f)(effect_params_t *params);
+
+typedef struct {
+    rgb_effect_f render;
+    uint8_t      flags;  // RGB_EFFECT_*
+} rgb_effect_t;
+
+// Every effect that is compiled in, indexed by mode
+static const rgb_effect_t rgb_effects[RGB_MATRIX_EFFECT_MAX] PROGMEM = {
+    [RGB_MATRIX_NONE] = {rgb_matrix_none, 0},
+
+// ---------------------------------------------
+// -----Begin rgb effect table macros-----------
+#define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_##name] = {name, __VA_ARGS__ + 0},
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+
+#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_CUSTOM_##name] = {name, __VA_ARGS__ + 0},
+#    ifdef RGB_MATRIX_CUSTOM_KB
+#        include "rgb_matrix_kb.inc"
+#    endif
+#    ifdef RGB_MATRIX_CUSTOM_USER
+#        include "rgb_matrix_user.inc"
+#    endif
+#    undef RGB_MATRIX_EFFECT
+#endif
+    // -----End rgb effect table macros-------------
+    // ---------------------------------------------
+};
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_DISABLE_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
@@ -320,9 +527,67 @@ static void rgb_task_sync(void) {
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
+#ifdef RGB_MATRIX_DEBUG_FPS
+static void rgb_task_fps(void) {
+    rgb_fps_count++;
+
+    uint32_t timer_now = timer_read32();
+    if (TIMER_DIFF_32(timer_now, rgb_fps_timer) > 1000) {
+#    if defined(RGB_MATRIX_RENDER_BUDGET)
+        dprintf("rgb matrix frame rate: %u, render time per LED: %luus/256\n", rgb_fps_count, rgb_render_cost);
+#    else
+        dprintf("rgb matrix frame rate: %u\n", rgb_fps_count);
+#    endif
+        rgb_fps_last  = rgb_fps_count;
+        rgb_fps_timer = timer_now;
+        rgb_fps_count = 0;
+    }
+}
+
+uint16_t rgb_matrix_get_fps(void) { return rgb_fps_last; }
+#else
+#    define rgb_task_fps()
+#endif  // RGB_MATRIX_DEBUG_FPS
+
+#ifdef RGB_MATRIX_RENDER_BUDGET
+static void rgb_task_render_limits(uint8_t effect) {
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0
+    // An expensive effect starts out at no more than RGB_MATRIX_LED_PROCESS_LIMIT LEDs
+    // per iteration, rather than going by what the previous effect cost
+    if (rgb_effect_params.init && rgb_effect_params.led_max == 0 && effect < RGB_MATRIX_EFFECT_MAX && (pgm_read_byte(&rgb_effects[effect].flags) & RGB_EFFECT_EXPENSIVE)) {
+        uint32_t cost = ((uint32_t)RGB_MATRIX_RENDER_BUDGET << 8) / RGB_MATRIX_LED_PROCESS_LIMIT;
+        if (rgb_render_cost < cost) rgb_render_cost = cost;
+    }
+#    endif
+
+    // Pick up where the last iteration stopped, with as many LEDs as are
+    // expected to fit in the budget going by what they have cost so far
+    uint32_t count = rgb_render_cost ? ((uint32_t)RGB_MATRIX_RENDER_BUDGET << 8) / rgb_render_cost : UINT8_MAX;
+    if (count == 0) count = 1;
+
+    rgb_effect_params.led_min = rgb_effect_params.led_max;
+    rgb_effect_params.led_max = count < UINT8_MAX - rgb_effect_params.led_min ? rgb_effect_params.led_min + count : UINT8_MAX;
+}
+
+static void rgb_task_render_cost(uint32_t start) {
+    uint8_t led_max = rgb_effect_params.led_max < DRIVER_LED_TOTAL ? rgb_effect_params.led_max : DRIVER_LED_TOTAL;
+    if (led_max <= rgb_effect_params.led_min) return;
+
+    // The timer only counts whole milliseconds, so a shorter render shows up as
+    // taking either none or one of them. How often it's one goes with how long
+    // it really takes, so averaged over many renders this is the actual cost.
+    uint32_t sample = (timer_elapsed32(start) * 1000 << 8) / (led_max - rgb_effect_params.led_min);
+    rgb_render_cost = rgb_render_cost - rgb_render_cost / 32 + sample / 32;
+}
+#endif  // RGB_MATRIX_RENDER_BUDGET
+
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_effect_params.led_max = 0;
+#endif
+    rgb_task_fps();
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -334,6 +599,19 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+void *rgb_matrix_framebuffer(void) { return rgb_framebuffer_owner == rgb_matrix_config.mode && rgb_framebuffer_owner != RGB_MATRIX_NONE ? rgb_framebuffer : NULL; }
+
+static void rgb_task_framebuffer(uint8_t effect) {
+    // Handed to the new effect if it uses it, without anything the last one left behind
+    rgb_framebuffer_owner = RGB_MATRIX_NONE;
+    if (effect < RGB_MATRIX_EFFECT_MAX && (pgm_read_byte(&rgb_effects[effect].flags) & RGB_EFFECT_FRAMEBUFFER)) {
+        memset(rgb_framebuffer, 0, sizeof(rgb_framebuffer));
+        rgb_framebuffer_owner = effect;
+    }
+}
+#endif  // RGB_MATRIX_FRAMEBUFFER_EFFECTS
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
@@ -342,46 +620,34 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
-    switch (effect) {
-        case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
-
-// ---------------------------------------------
-// -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
-#include "rgb_matrix_effects.inc"
-#undef RGB_MATRIX_EFFECT
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+    // The mode can change mid-frame, so hand it over on whichever iteration the new effect starts at
+    if (rgb_effect_params.init && rgb_framebuffer_owner != effect) {
+        rgb_task_framebuffer(effect);
+    }
+#endif
 
-#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
-#    ifdef RGB_MATRIX_CUSTOM_KB
-#        include "rgb_matrix_kb.inc"
-#    endif
-#    ifdef RGB_MATRIX_CUSTOM_USER
-#        include "rgb_matrix_user.inc"
-#    endif
-#    undef RGB_MATRIX_EFFECT
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_task_render_limits(effect);
+    uint32_t render_start = timer_read32();
 #endif
-            // -----End rgb effect switch case macros-------
-            // ---------------------------------------------
 
+    // each effect can opt to do calculations
+    // and/or request PWM buffer updates.
+    if (effect < RGB_MATRIX_EFFECT_MAX) {
+        rgb_effect_f render = pgm_read_ptr(&rgb_effects[effect].render);
+        rendering           = render(&rgb_effect_params);
+    } else if (effect == UINT8_MAX) {
         // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+        rgb_matrix_test();
+        rgb_task_state = FLUSHING;
+        return;
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_task_render_cost(render_start);
+#endif
+
     rgb_effect_params.iter++;
 
     // next task
@@ -401,12 +667,40 @@ static void rgb_task_flush(uint8_t effect) {
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+    rgb_split_flush();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
 }
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+// The master renders both halves, the slave only shows the colors it's sent
+static void rgb_task_split_slave(void) {
+    if (suspend_state != rgb_split_suspended) {
+        // Turn off while suspended, the master sends every color again within RGB_MATRIX_SPLIT_STREAM_REFRESH once awake
+        rgb_split_suspended = suspend_state;
+        rgb_split_received  = true;
+    }
+    if (!rgb_split_received || sync_timer_elapsed32(g_rgb_timer) < RGB_MATRIX_LED_FLUSH_LIMIT) return;
+
+    g_rgb_timer        = sync_timer_read32();
+    rgb_split_received = false;
+    if (rgb_split_suspended) {
+        rgb_matrix_driver.set_color_all(0, 0, 0);
+    }
+    rgb_matrix_update_pwm_buffers();
+}
+#endif
+
 void rgb_matrix_task(void) {
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+    if (!is_keyboard_master()) {
+        rgb_task_split_slave();
+        return;
+    }
+#endif
     rgb_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
@@ -437,6 +731,10 @@ void rgb_matrix_task(void) {
             rgb_task_sync();
             break;
     }
+    // A frame in progress carries on in the next call
+    if (rgb_task_state != SYNCING) {
+        keyboard_task_busy();
+    }
 }
 
 void rgb_matrix_indicators(void) {
@@ -454,7 +752,11 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      * and not sure which would be better. Otherwise, this should be called from
      * rgb_task_render, right before the iter++ line.
      */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#if defined(RGB_MATRIX_RENDER_BUDGET)
+    uint8_t min = params->led_min;
+    uint8_t max = params->led_max;
+    if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
     uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
     uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
     if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
@@ -470,8 +772,29 @@ __attribute__((weak)) void rgb_matrix_indicators_advanced_kb(uint8_t led_min, ui
 
 __attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
 
+#ifdef RGB_MATRIX_POLAR_ENABLED
+static void rgb_matrix_init_polar(void) {
+    // The effects only need these relative to the center, which doesn't move,
+    // so they're not worked out again for every LED on every frame.
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif  // RGB_MATRIX_POLAR_ENABLED
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+#ifdef RGB_MATRIX_POLAR_ENABLED
+    rgb_matrix_init_polar();
+#endif  // RGB_MATRIX_POLAR_ENABLED
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+    // send the slave every color to start with
+    memset(rgb_split_dirty, 0xFF, sizeof(rgb_split_dirty));
+#endif
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
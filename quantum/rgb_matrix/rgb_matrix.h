@@ -42,11 +42,40 @@
 #    define RGB_MATRIX_LED_FLUSH_LIMIT 16
 #endif
 
+// LEDs the effect runners collect before converting their colours to RGB in one go
+#ifndef RGB_MATRIX_HSV_BATCH
+#    define RGB_MATRIX_HSV_BATCH 16
+#endif
+
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+// Bytes of scratch memory shared by the framebuffer effects, enough for the largest of them
+#    ifndef RGB_MATRIX_FRAMEBUFFER_SIZE
+#        define RGB_MATRIX_FRAMEBUFFER_SIZE (MATRIX_ROWS * MATRIX_COLS)
+#    endif
+#endif
+
+#if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+// LEDs of the other half the master sends to the slave per transaction
+#    ifndef RGB_MATRIX_SPLIT_STREAM_LEDS
+#        define RGB_MATRIX_SPLIT_STREAM_LEDS 16
+#    endif
+
+// The master sends every LED of the other half again this often (in milliseconds), in case the slave missed some
+#    ifndef RGB_MATRIX_SPLIT_STREAM_REFRESH
+#        define RGB_MATRIX_SPLIT_STREAM_REFRESH 1000
+#    endif
+#endif
+
 #ifndef RGB_MATRIX_LED_PROCESS_LIMIT
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#if defined(RGB_MATRIX_RENDER_BUDGET)
+#    define RGB_MATRIX_USE_LIMITS(min, max) \
+        uint8_t min = params->led_min;      \
+        uint8_t max = params->led_max;      \
+        if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
 #    define RGB_MATRIX_USE_LIMITS(min, max)                        \
         uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
         uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
@@ -115,8 +144,33 @@ void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+// The framebuffer, cleared when the current effect started, or NULL if the effect isn't flagged RGB_EFFECT_FRAMEBUFFER
+void *rgb_matrix_framebuffer(void);
+#endif
+
+#if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+#    ifndef RGB_MATRIX_KEYREACTIVE_ENABLED
+#        error "RGB_MATRIX_SPLIT_HITS needs RGB_MATRIX_KEYPRESSES or RGB_MATRIX_KEYRELEASES"
+#    endif
+// master: take up to max hits on this half that the slave doesn't know about yet
+uint8_t rgb_matrix_split_hits_take(rgb_split_hit_t *hits, uint8_t max);
+// slave: add the hits sent by the master
+void rgb_matrix_split_hits_apply(const rgb_split_hit_t *hits, uint8_t count);
+#endif
+
+#if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+// master: take up to max LEDs of the other half that changed since they were last taken
+uint8_t rgb_matrix_split_stream_take(rgb_split_led_t *leds, uint8_t max);
+// slave: show the LEDs sent by the master
+void rgb_matrix_split_stream_apply(const rgb_split_led_t *leds, uint8_t count);
+#endif
+
 void        rgb_matrix_set_suspend_state(bool state);
 bool        rgb_matrix_get_suspend_state(void);
+#ifdef RGB_MATRIX_DEBUG_FPS
+uint16_t rgb_matrix_get_fps(void);  // Number of frames rendered in the last second
+#endif
 void        rgb_matrix_toggle(void);
 void        rgb_matrix_toggle_noeeprom(void);
 void        rgb_matrix_enable(void);
@@ -219,9 +273,9 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_POLAR_ENABLED
+extern led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
-#ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
-extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
-#endif
@@ -34,6 +34,11 @@
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+// The effects using the LED positions relative to the center, and custom ones that might
+#if !defined(DISABLE_RGB_MATRIX_CYCLE_OUT_IN) || !defined(DISABLE_RGB_MATRIX_CYCLE_PINWHEEL) || !defined(DISABLE_RGB_MATRIX_CYCLE_SPIRAL) || !defined(DISABLE_RGB_MATRIX_BAND_SPIRAL_SAT) || !defined(DISABLE_RGB_MATRIX_BAND_SPIRAL_VAL) || !defined(DISABLE_RGB_MATRIX_BAND_PINWHEEL_SAT) || !defined(DISABLE_RGB_MATRIX_BAND_PINWHEEL_VAL) || defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_POLAR_ENABLED
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -47,7 +52,25 @@ typedef struct PACKED {
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
 } last_hit_t;
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+#    if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+// A hit on the master's half, as sent to the slave
+typedef struct PACKED {
+    uint8_t  index;
+    uint16_t tick;
+} rgb_split_hit_t;
+#    endif  // defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+#endif      // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+#if defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+// The color of one LED, as streamed from the master to the slave
+typedef struct PACKED {
+    uint8_t index;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} rgb_split_led_t;
+#endif  // defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
 
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
@@ -57,6 +80,11 @@ typedef struct PACKED {
     uint8_t     iter;
     led_flags_t flags;
     bool        init;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    // The LEDs to render in this iteration, picked to fit in the budget
+    uint8_t led_min;
+    uint8_t led_max;
+#endif
 } effect_params_t;
 
 typedef struct PACKED {
@@ -64,6 +92,12 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+// Where an LED is relative to the center, worked out once by rgb_matrix_init()
+typedef struct PACKED {
+    uint8_t dist;
+    uint8_t angle;
+} led_polar_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -76,6 +110,10 @@ typedef struct PACKED {
 
 #define NO_LED 255
 
+// What an effect needs, given as the second argument of RGB_MATRIX_EFFECT()
+#define RGB_EFFECT_FRAMEBUFFER 0x01  // keeps its state in rgb_matrix_framebuffer()
+#define RGB_EFFECT_EXPENSIVE 0x02    // does a lot of work per LED, such as going through every recent hit
+
 typedef struct PACKED {
     uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
     led_point_t point[DRIVER_LED_TOTAL];
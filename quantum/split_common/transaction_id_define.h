@@ -21,9 +21,13 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif  // USE_I2C
 
-    GET_SLAVE_MATRIX_CHECKSUM,
+    GET_SLAVE_MATRIX_DELTA,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    GET_SLAVE_MATRIX_BATCH,
+#endif  // SPLIT_TRANSACTION_BATCH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif  // SPLIT_TRANSPORT_MIRROR
@@ -60,16 +64,32 @@ enum serial_transaction_id {
 
 #if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
     PUT_LED_MATRIX,
+#    ifdef LED_MATRIX_SPLIT_HITS
+    PUT_LED_MATRIX_HITS,
+    GET_LED_MATRIX_HITS_ACK,
+#    endif  // LED_MATRIX_SPLIT_HITS
 #endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     PUT_RGB_MATRIX,
+#    ifdef RGB_MATRIX_SPLIT_HITS
+    PUT_RGB_MATRIX_HITS,
+    GET_RGB_MATRIX_HITS_ACK,
+#    endif  // RGB_MATRIX_SPLIT_HITS
+#    ifdef RGB_MATRIX_SPLIT_STREAM
+    PUT_RGB_MATRIX_LEDS,
+    GET_RGB_MATRIX_LEDS_ACK,
+#    endif  // RGB_MATRIX_SPLIT_STREAM
 #endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
     PUT_WPM,
 #endif  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+#ifdef SPLIT_STREAM_ENABLE
+    PUT_STREAM_FRAGMENT,
+#endif  // SPLIT_STREAM_ENABLE
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
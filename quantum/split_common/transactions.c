@@ -32,7 +32,7 @@
 #endif  // FORCED_SYNC_THROTTLE_MS
 
 // Max number of consecutive failed communications before the communication is seen as disconnected.
-// All built-in transactions (i.e. not transaction_rpc_*-based ones) are given 10 attempts each, and most send one transaction over the transport, so 40 errors is basically (up to) four completely failed built-in transactions.
+// All built-in transactions (i.e. not transaction_rpc_*-based ones) are given up to SPLIT_TRANSACTION_MAX_ATTEMPTS (10) attempts each, and most send one transaction over the transport, so 40 errors is basically (up to) four completely failed built-in transactions.
 // On the other hand, each RPC transaction consists of four transport transactions without retries, so 40 errors is roughly ten completely failed RPC transactions.
 // Set to a negative value to disable the disconnection check altogether.
 #ifndef SPLIT_MAX_CONNECTION_ERRORS
@@ -45,6 +45,35 @@
 #    define SPLIT_CONNECTION_CHECK_TIMEOUT 500
 #endif  // SPLIT_CONNECTION_CHECK_TIMEOUT
 
+// Most attempts at a built-in transaction, when the link is healthy. The worse the recent success rate, the fewer
+// attempts are made, down to one, so that a flaky or missing half doesn't stall every scan.
+#ifndef SPLIT_TRANSACTION_MAX_ATTEMPTS
+#    define SPLIT_TRANSACTION_MAX_ATTEMPTS 10
+#endif  // SPLIT_TRANSACTION_MAX_ATTEMPTS
+
+// Most writes of replicated state (layers, mods, and so on) per scan, 0 for no limit. When there are more changes
+// than that, the rest are sent over the next scans, so that a lot of changes at once don't stall the scan.
+#ifndef SPLIT_SYNC_WRITES_PER_SCAN
+#    define SPLIT_SYNC_WRITES_PER_SCAN 0
+#endif  // SPLIT_SYNC_WRITES_PER_SCAN
+
+#ifdef SPLIT_STREAM_ENABLE
+// Most stream fragments sent ahead of the last one the slave has confirmed
+#    ifndef SPLIT_STREAM_WINDOW
+#        define SPLIT_STREAM_WINDOW 2
+#    endif  // SPLIT_STREAM_WINDOW
+
+// Most stream fragments sent per scan
+#    ifndef SPLIT_STREAM_FRAGMENTS_PER_SCAN
+#        define SPLIT_STREAM_FRAGMENTS_PER_SCAN 1
+#    endif  // SPLIT_STREAM_FRAGMENTS_PER_SCAN
+
+// How long (in milliseconds) a stream may go without the slave receiving any more of it, before it's given up on
+#    ifndef SPLIT_STREAM_TIMEOUT
+#        define SPLIT_STREAM_TIMEOUT 500
+#    endif  // SPLIT_STREAM_TIMEOUT
+#endif      // SPLIT_STREAM_ENABLE
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -55,9 +84,27 @@
     { &dummy, 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
+#define trans_bidirectional_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { &dummy, sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb }
+
 #define transport_write(id, data, length) transport_transaction(id, data, length, NULL, 0)
 #define transport_read(id, data, length) transport_transaction(id, NULL, 0, data, length)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+// Everything the master writes is at the end of the shared memory, starting with the slave matrix checksum
+#    define SPLIT_BATCH_OFFSET offsetof(split_shared_memory_t, smatrix_base_checksum)
+#    define SPLIT_BATCH_SIZE (sizeof(split_shared_memory_t) - SPLIT_BATCH_OFFSET)
+
+_Static_assert(SPLIT_BATCH_SIZE <= UINT8_MAX, "Too much split data to send in one batch, disable SPLIT_TRANSACTION_BATCH");
+
+static bool batch_staging  = false;  // writes to the slave are staged in shared memory instead of sent
+static bool batch_dirty    = false;  // staged writes haven't been sent yet
+static bool batch_numbered = false;  // the staged writes have their sequence number
+
+static uint8_t batch_accepted = 0;  // slave: sequence of the last batch, 0 if it arrived damaged
+static uint8_t batch_applied  = 0;  // slave: sequence of the last batch applied
+#endif  // SPLIT_TRANSACTION_BATCH
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
@@ -67,19 +114,79 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 ////////////////////////////////////////////////////
 // Helpers
 
-bool transport_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
-#if SPLIT_MAX_CONNECTION_ERRORS < 0
-    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
-#else   // SPLIT_MAX_CONNECTION_ERRORS < 0
-    // Throttle transaction attempts if target doesn't seem to be connected
-    // Without this, a solo half becomes unusable due to constant read timeouts
-    static uint8_t  connection_errors      = 0;
-    static uint16_t connection_check_timer = 0;
-    if (connection_errors >= SPLIT_MAX_CONNECTION_ERRORS && timer_elapsed(connection_check_timer) < SPLIT_CONNECTION_CHECK_TIMEOUT) {
+#ifdef SPLIT_TRANSACTION_BATCH
+static bool batch_stage(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    // Only plain writes into the batched block can wait
+    if (target2initiator_length > 0 || trans->slave_callback || trans->initiator2target_offset < SPLIT_BATCH_OFFSET) {
         return false;
     }
 
-    if (!transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length)) {
+    size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+    memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    batch_dirty    = true;
+    batch_numbered = false;
+    return true;
+}
+
+static uint16_t batch_crc(void) { return crc16((const uint8_t *)split_shmem + SPLIT_BATCH_OFFSET, offsetof(split_shared_memory_t, batch_trailer.crc) - SPLIT_BATCH_OFFSET); }
+
+// Slave: whether the batch with this sequence is still the last one accepted, and hasn't been applied yet
+static bool batch_applies(uint8_t sequence) { return sequence != 0 && sequence == batch_accepted && sequence != batch_applied; }
+#endif  // SPLIT_TRANSACTION_BATCH
+
+#if SPLIT_MAX_CONNECTION_ERRORS >= 0
+static uint8_t  connection_errors      = 0;
+static uint16_t connection_check_timer = 0;
+#endif  // SPLIT_MAX_CONNECTION_ERRORS >= 0
+
+static uint8_t link_quality = UINT8_MAX;  // recent success rate of the transport, UINT8_MAX when nothing fails
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+static split_link_stats_t link_stats;
+
+static inline void link_stats_increment(uint16_t *counter) {
+    if (*counter < UINT16_MAX) {
+        (*counter)++;
+    }
+}
+#endif  // SPLIT_LINK_STATS_ENABLE
+
+static void transport_record(int8_t id, bool okay, uint16_t elapsed) {
+    // Move an eighth of the way towards the latest result
+    if (okay) {
+        link_quality += (UINT8_MAX - link_quality + 7) / 8;
+    } else {
+        link_quality -= (link_quality + 7) / 8;
+    }
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+    link_stats_increment(&link_stats.transactions[id]);
+    if (okay) {
+        uint8_t bucket = 0;
+        while (bucket < SPLIT_LINK_STATS_LATENCY_BUCKETS - 1 && elapsed >= (1U << bucket)) {
+            bucket++;
+        }
+        link_stats_increment(&link_stats.latency[bucket]);
+    } else {
+        link_stats_increment(&link_stats.errors[id]);
+    }
+#endif  // SPLIT_LINK_STATS_ENABLE
+}
+
+// Throttle transaction attempts if target doesn't seem to be connected
+// Without this, a solo half becomes unusable due to constant read timeouts
+static bool transport_connection_throttled(void) {
+#if SPLIT_MAX_CONNECTION_ERRORS < 0
+    return false;
+#else   // SPLIT_MAX_CONNECTION_ERRORS < 0
+    return connection_errors >= SPLIT_MAX_CONNECTION_ERRORS && timer_elapsed(connection_check_timer) < SPLIT_CONNECTION_CHECK_TIMEOUT;
+#endif  // SPLIT_MAX_CONNECTION_ERRORS < 0
+}
+
+static bool transport_connection_update(bool okay) {
+#if SPLIT_MAX_CONNECTION_ERRORS >= 0
+    if (!okay) {
         if (connection_errors < UINT8_MAX) {
             connection_errors++;
         }
@@ -93,24 +200,49 @@ bool transport_transaction(int8_t id, const void *initiator2target_buf, uint16_t
     }
 
     connection_errors = 0;
-    return true;
-#endif  // SPLIT_MAX_CONNECTION_ERRORS < 0
+#endif  // SPLIT_MAX_CONNECTION_ERRORS >= 0
+    return okay;
+}
+
+bool transport_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    if (batch_staging && batch_stage(id, initiator2target_buf, initiator2target_length, target2initiator_length)) {
+        return true;
+    }
+#endif  // SPLIT_TRANSACTION_BATCH
+
+    if (transport_connection_throttled()) {
+        return false;
+    }
+
+    uint16_t start = timer_read();
+    bool     okay  = transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    transport_record(id, okay, timer_elapsed(start));
+    return transport_connection_update(okay);
 }
 
 bool transaction_handler_master(bool okay, matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
     if (okay) {
-        bool this_okay = true;
-        for (int iter = 1; iter <= 10; ++iter) {
+        bool    this_okay = true;
+        uint8_t attempts  = 1 + ((SPLIT_TRANSACTION_MAX_ATTEMPTS - 1) * link_quality + UINT8_MAX - 1) / UINT8_MAX;
+        for (int iter = 1; iter <= attempts; ++iter) {
             if (!this_okay) {
+#ifdef SPLIT_LINK_STATS_ENABLE
+                link_stats_increment(&link_stats.retries);
+#endif  // SPLIT_LINK_STATS_ENABLE
+                // The transport drivers disable interrupts themselves where their timing needs it
                 for (int i = 0; i < iter * iter; ++i) {
                     wait_us(10);
                 }
             }
-            ATOMIC_BLOCK_FORCEON { this_okay = handler(master_matrix, slave_matrix); };
+            this_okay = handler(master_matrix, slave_matrix);
             if (this_okay) break;
         }
         okay &= this_okay;
         if (!okay) {
+#ifdef SPLIT_LINK_STATS_ENABLE
+            link_stats_increment(&link_stats.failures);
+#endif  // SPLIT_LINK_STATS_ENABLE
             dprintf("Failed to execute %s\n", prefix);
         }
     }
@@ -127,12 +259,24 @@ bool transaction_handler_master(bool okay, matrix_row_t master_matrix[], matrix_
         ATOMIC_BLOCK_FORCEON { prefix##_slave(master_matrix, slave_matrix); }; \
     } while (0)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+// The master's writes only arrive in batches, each is applied once and only if it arrived intact
+#    define TRANSACTION_HANDLER_SLAVE_BATCHED(prefix)                                           \
+        do {                                                                                    \
+            ATOMIC_BLOCK_FORCEON {                                                              \
+                if (batch_applies(batch_sequence)) prefix##_slave(master_matrix, slave_matrix); \
+            };                                                                                  \
+        } while (0)
+#else  // SPLIT_TRANSACTION_BATCH
+#    define TRANSACTION_HANDLER_SLAVE_BATCHED(prefix) TRANSACTION_HANDLER_SLAVE(prefix)
+#endif  // SPLIT_TRANSACTION_BATCH
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
-    uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
-    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
+    uint16_t curr_checksum;
+    bool     okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc16(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        okay &= curr_checksum == crc16(equiv_shmem, length);
         if (okay) {
             *last_update = timer_read32();
         }
@@ -142,6 +286,95 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     return okay;
 }
 
+// When replicated state is sent to the slave, besides every time its throttle has passed
+typedef enum {
+    SPLIT_SYNC_ON_CHANGE,  // Whenever it differs from what was last sent
+    SPLIT_SYNC_PERIODIC,   // Never, e.g. because it changes all the time
+} split_sync_policy_t;
+
+// State the master replicates to the slave through an initiator2target transaction
+typedef struct {
+    int8_t              transaction_id;
+    split_sync_policy_t policy;
+    uint16_t            throttle;      // Milliseconds after which it's sent again anyway
+    void (*snapshot)(void *state);     // Master: fill the zeroed transaction buffer with the current state
+    void (*apply)(const void *state);  // Slave: apply the state received from the master
+} split_sync_state_t;
+
+// Data the slave has to see exactly once. It starts with a sequence number, and is sent until the slave sends back
+// that it has seen it. Once it has gone through, only the acknowledgement is read back until the slave has seen it.
+typedef struct _split_acked_t {
+    bool    pending;     // the slave hasn't seen the data yet
+    bool    sent;        // the data has reached the slave at least once
+    uint8_t ack_before;  // the acknowledgement the slave sent back when the data reached it
+} split_acked_t;
+
+static void acked_next_sequence(uint8_t *sequence) {
+    if (++(*sequence) == 0) {
+        *sequence = 1;
+    }
+}
+
+// take fills in the next data to send, and returns false if there's nothing to send
+static bool send_acked(int8_t trans_id, int8_t ack_trans_id, split_acked_t *acked, void *data, size_t length, bool (*take)(void *data)) {
+    uint8_t *sequence = data;
+    bool     okay     = true;
+    while (okay) {
+        if (acked->pending && acked->sent) {
+            // Sending the data again only to get the acknowledgement back would take much longer
+            uint8_t ack;
+            okay = transport_read(ack_trans_id, &ack, sizeof(ack));
+            if (!okay || ack == acked->ack_before) {
+                // The slave hasn't got round to it yet
+                break;
+            }
+            // Unless the slave has lost it, e.g. because it has restarted, in which case it's sent again
+            acked->pending = ack != *sequence;
+        }
+
+        if (!acked->pending) {
+            if (!take(data)) {
+                break;
+            }
+            acked_next_sequence(sequence);
+            acked->pending = true;
+            acked->sent    = false;
+        }
+
+        uint8_t ack;
+        okay = transport_transaction(trans_id, data, length, &ack, sizeof(ack));
+        if (okay) {
+            // The acknowledgement is from before the slave has seen this transaction
+            if (ack != *sequence) {
+                acked->sent       = true;
+                acked->ack_before = ack;
+                break;
+            } else if (acked->sent) {
+                // Seen, carry on with the next data
+                acked->pending = false;
+            } else {
+                // Left over from before the master started, the slave would take the data for a repeat
+                acked_next_sequence(sequence);
+            }
+        }
+    }
+    if (acked->pending) {
+        keyboard_task_busy();
+    }
+    return okay;
+}
+
+// Returns true if the slave hasn't seen the data yet, and sends back that it has
+static bool receive_acked(const void *data, uint8_t *last_sequence, uint8_t *ack) {
+    uint8_t sequence = *(const uint8_t *)data;
+    if (sequence == *last_sequence) {
+        return false;
+    }
+    *last_sequence = sequence;
+    *ack           = sequence;
+    return true;
+}
+
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
@@ -161,32 +394,252 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
-static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t     last_update                    = 0;
-    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0};  // last successfully-read matrix, so we can replicate if there are checksum errors
-    matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];        // holding area while we test whether or not checksum is correct
+// The master sends the checksum of the slave matrix it holds, and gets back the rows that changed since, in a single
+// transaction. Reading the whole matrix is kept for resynchronisation.
+
+static uint32_t     slave_matrix_last_update             = 0;
+static matrix_row_t slave_matrix_last[(MATRIX_ROWS) / 2] = {0};  // last successfully-read matrix, so we can replicate if there are checksum errors
+#if defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+static split_slave_encoder_sync_t slave_encoders_last;  // encoder state from the last accepted reply
+#endif  // defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+
+// Picks the slave matrix request, and puts the checksum of the last matrix in place for it
+static int8_t slave_matrix_request_prepare(void) {
+    split_shmem->smatrix_base_checksum = crc16(slave_matrix_last, sizeof(slave_matrix_last));
+#ifdef SPLIT_TRANSACTION_BATCH
+    if (batch_dirty) {
+        // The staged writes are already in place, send them along with the checksum. A resend keeps its sequence, so
+        // that the slave doesn't apply the same writes twice.
+        split_batch_trailer_t *trailer = &split_shmem->batch_trailer;
+        if (!batch_numbered) {
+            acked_next_sequence(&trailer->sequence);
+            batch_numbered = true;
+        }
+        trailer->crc = batch_crc();
+        return GET_SLAVE_MATRIX_BATCH;
+    }
+#endif  // SPLIT_TRANSACTION_BATCH
+    return GET_SLAVE_MATRIX_DELTA;
+}
+
+static void slave_matrix_request_done(void) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    batch_dirty = false;
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    // The next batch mustn't make the slave apply the same changes again
+    split_shmem->rgblight_sync.status.change_flags = 0;
+#    endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+#endif      // SPLIT_TRANSACTION_BATCH
+}
+
+// Applies the reply to the last matrix, or reads the whole matrix if they don't add up
+static bool slave_matrix_apply(const split_slave_reply_t *reply) {
+    static uint8_t                    last_sequence = 0;
+    const split_slave_matrix_delta_t *delta         = &reply->matrix;
+    matrix_row_t                      temp_matrix[(MATRIX_ROWS) / 2];  // holding area while we test whether or not checksum is correct
+
+    // Reject replies damaged on the way, or left over from an earlier transaction
+    if (reply->crc != crc16(reply, offsetof(split_slave_reply_t, crc)) || reply->sequence == last_sequence) {
+        return false;
+    }
+    last_sequence = reply->sequence;
+#if defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+    slave_encoders_last = reply->encoders;
+#endif  // defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+
+    bool resync = delta->count > SPLIT_MATRIX_DELTA_ROWS || timer_elapsed32(slave_matrix_last_update) >= FORCED_SYNC_THROTTLE_MS;
+    if (!resync) {
+        memcpy(temp_matrix, slave_matrix_last, sizeof(temp_matrix));
+        for (uint8_t i = 0; i < delta->count; i++) {
+            if (delta->rows[i] >= (MATRIX_ROWS) / 2) {
+                resync = true;
+                break;
+            }
+            temp_matrix[delta->rows[i]] = delta->values[i];
+        }
+        resync = resync || delta->checksum != crc16(temp_matrix, sizeof(temp_matrix));
+    }
+
+    if (resync) {
+        split_slave_matrix_sync_t smatrix;
+        if (!transport_read(GET_SLAVE_MATRIX_DATA, &smatrix, sizeof(smatrix)) || smatrix.checksum != crc16(smatrix.matrix, sizeof(smatrix.matrix))) {
+            return false;
+        }
+        memcpy(temp_matrix, smatrix.matrix, sizeof(temp_matrix));
+        slave_matrix_last_update = timer_read32();
+    }
+
+    // Checksum matches the received data, save as the last matrix state
+    memcpy(slave_matrix_last, temp_matrix, sizeof(temp_matrix));
+    return true;
+}
+
+#ifdef SERIAL_USART_ASYNC
+
+// The slave matrix is requested at the end of a scan, and collected at the start of the next one, so the scan doesn't
+// wait for the transport. Collecting waits if the request has taken longer than the latency budget.
+
+#    ifndef SERIAL_USART_ASYNC_BUDGET_MS
+#        define SERIAL_USART_ASYNC_BUDGET_MS 5
+#    endif  // SERIAL_USART_ASYNC_BUDGET_MS
+
+static bool     slave_matrix_in_flight = false;
+static int8_t   slave_matrix_posted_id = 0;
+static uint16_t slave_matrix_posted_at = 0;
 
-    bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+static bool slave_matrix_post(void) {
+    if (!slave_matrix_in_flight && !transport_connection_throttled()) {
+        slave_matrix_posted_id = slave_matrix_request_prepare();
+        slave_matrix_in_flight = transport_post_transaction(slave_matrix_posted_id, &split_shmem->smatrix_base_checksum, split_transaction_table[slave_matrix_posted_id].initiator2target_buffer_size);
+        slave_matrix_posted_at = timer_read();
+    }
+    // The reply doesn't wake the MCU from idle sleep, so don't sleep while waiting for it
+    if (slave_matrix_in_flight) {
+        keyboard_task_busy();
+    }
+    return slave_matrix_in_flight;
+}
+
+static bool slave_matrix_collect(matrix_row_t slave_matrix[]) {
+    bool okay = true;
+    if (slave_matrix_in_flight) {
+        split_slave_reply_t reply;
+        bool                late   = timer_elapsed(slave_matrix_posted_at) >= SERIAL_USART_ASYNC_BUDGET_MS;
+        transport_status_t  status = transport_poll_transaction(&reply, sizeof(reply), late);
+        if (status != TRANSPORT_PENDING) {
+            if (late) {
+                dprintf("Slave matrix over latency budget, waited %ums\n", timer_elapsed(slave_matrix_posted_at));
+            }
+            slave_matrix_in_flight = false;
+            transport_record(slave_matrix_posted_id, status == TRANSPORT_SUCCESS, timer_elapsed(slave_matrix_posted_at));
+            okay = transport_connection_update(status == TRANSPORT_SUCCESS);
+            if (okay) {
+                okay = slave_matrix_apply(&reply);
+            }
+            if (okay) {
+                slave_matrix_request_done();
+            }
+        }
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, slave_matrix_last, sizeof(slave_matrix_last));
+    return okay;
+}
+
+#else  // SERIAL_USART_ASYNC
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_slave_reply_t reply;
+    int8_t              id   = slave_matrix_request_prepare();
+    bool                okay = transport_transaction(id, &split_shmem->smatrix_base_checksum, split_transaction_table[id].initiator2target_buffer_size, &reply, sizeof(reply));
+    okay = okay && slave_matrix_apply(&reply);
     if (okay) {
-        // Checksum matches the received data, save as the last matrix state
-        memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+        slave_matrix_request_done();
     }
     // Copy out the last-known-good matrix state to the slave matrix
-    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    memcpy(slave_matrix, slave_matrix_last, sizeof(slave_matrix_last));
     return okay;
 }
 
+#endif  // SERIAL_USART_ASYNC
+
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
-    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc16(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+}
+
+// The last two matrices sent to the master, newest first. Some transports run the callback before receiving the
+// master's checksum, so it can lag one transaction behind.
+static matrix_row_t slave_matrix_sent[2][(MATRIX_ROWS) / 2];
+static uint16_t     slave_matrix_sent_checksum[2];
+
+static void slave_matrix_push_sent(void) {
+    memcpy(slave_matrix_sent[1], slave_matrix_sent[0], sizeof(slave_matrix_sent[1]));
+    slave_matrix_sent_checksum[1] = slave_matrix_sent_checksum[0];
+    memcpy(slave_matrix_sent[0], split_shmem->smatrix.matrix, sizeof(slave_matrix_sent[0]));
+    slave_matrix_sent_checksum[0] = split_shmem->smatrix.checksum;
 }
 
+static void slave_matrix_delta_fill(split_slave_matrix_delta_t *delta) {
+    const matrix_row_t *base = NULL;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        if (split_shmem->smatrix_base_checksum == slave_matrix_sent_checksum[i]) {
+            base = slave_matrix_sent[i];
+            break;
+        }
+    }
+
+    delta->checksum = split_shmem->smatrix.checksum;
+    delta->count    = 0;
+    if (!base) {
+        // the master holds neither, it has to read the whole matrix
+        delta->count = SPLIT_MATRIX_DELTA_RESYNC;
+        return;
+    }
+
+    // Sending the new state of the rows, rather than the changed bits, also works when applied to a newer base
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        if (split_shmem->smatrix.matrix[row] != base[row]) {
+            if (delta->count == SPLIT_MATRIX_DELTA_ROWS) {
+                delta->count = SPLIT_MATRIX_DELTA_RESYNC;
+                return;
+            }
+            delta->rows[delta->count]   = row;
+            delta->values[delta->count] = split_shmem->smatrix.matrix[row];
+            delta->count++;
+        }
+    }
+
+    slave_matrix_push_sent();
+}
+
+static void slave_matrix_delta_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_slave_reply_t *reply = &split_shmem->slave_reply;
+
+    slave_matrix_delta_fill(&reply->matrix);
+#if defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+    reply->encoders = split_shmem->encoders;
+#endif  // defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+    reply->sequence++;
+    reply->crc = crc16(reply, offsetof(split_slave_reply_t, crc));
+}
+
+#ifdef SPLIT_TRANSACTION_BATCH
+static void slave_matrix_batch_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    if (split_shmem->batch_trailer.crc != batch_crc()) {
+        // Damaged on the way, nothing in it is applied. The stale reply makes the master send it again.
+        batch_accepted = 0;
+        return;
+    }
+    batch_accepted = split_shmem->batch_trailer.sequence;
+    slave_matrix_delta_callback(initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+}
+#endif  // SPLIT_TRANSACTION_BATCH
+
+static void slave_matrix_resync_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // the master now holds the whole matrix about to be sent
+    slave_matrix_push_sent();
+}
+
+#ifdef SPLIT_TRANSACTION_BATCH
+#    define TRANSACTIONS_SLAVE_MATRIX_BATCH_REGISTRATIONS [GET_SLAVE_MATRIX_BATCH] = {&dummy, SPLIT_BATCH_SIZE, SPLIT_BATCH_OFFSET, sizeof_member(split_shared_memory_t, slave_reply), offsetof(split_shared_memory_t, slave_reply), slave_matrix_batch_callback},
+#else  // SPLIT_TRANSACTION_BATCH
+#    define TRANSACTIONS_SLAVE_MATRIX_BATCH_REGISTRATIONS
+#endif  // SPLIT_TRANSACTION_BATCH
+
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix_handlers)
+#ifdef SERIAL_USART_ASYNC
+#    define TRANSACTIONS_SLAVE_MATRIX_COLLECT() okay &= slave_matrix_collect(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_POST() okay &= slave_matrix_post()
+#else  // SERIAL_USART_ASYNC
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix_handlers)
+#endif  // SERIAL_USART_ASYNC
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix_handlers)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
-    [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DELTA] = trans_bidirectional_initializer_cb(smatrix_base_checksum, slave_reply, slave_matrix_delta_callback), \
+    [GET_SLAVE_MATRIX_DATA]  = trans_target2initiator_initializer_cb(smatrix, slave_matrix_resync_callback), \
+    TRANSACTIONS_SLAVE_MATRIX_BATCH_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -205,7 +658,7 @@ static void master_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_ro
 }
 
 #    define TRANSACTIONS_MASTER_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(master_matrix_handlers)
-#    define TRANSACTIONS_MASTER_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(master_matrix_handlers)
+#    define TRANSACTIONS_MASTER_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_BATCHED(master_matrix_handlers)
 #    define TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS [PUT_MASTER_MATRIX] = trans_initiator2target_initializer(mmatrix.matrix),
 
 #else  // SPLIT_TRANSPORT_MIRROR
@@ -222,11 +675,19 @@ static void master_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_ro
 #ifdef ENCODER_ENABLE
 
 static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#    ifdef SPLIT_TRANSACTION_BATCH
+    // The encoder state came along with the slave matrix
+    split_slave_encoder_sync_t encoders = slave_encoders_last;
+
+    bool okay = encoders.checksum == crc16(encoders.state, sizeof(encoders.state));
+    if (okay) encoder_update_raw(encoders.state);
+#    else   // SPLIT_TRANSACTION_BATCH
     static uint32_t last_update = 0;
     uint8_t         temp_state[NUMBER_OF_ENCODERS];
 
     bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, temp_state, split_shmem->encoders.state, sizeof(temp_state));
     if (okay) encoder_update_raw(temp_state);
+#    endif  // SPLIT_TRANSACTION_BATCH
     return okay;
 }
 
@@ -236,7 +697,7 @@ static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sl
     // Always prepare the encoder state for read.
     memcpy(split_shmem->encoders.state, encoder_state, sizeof(encoder_state));
     // Now update the checksum given that the encoders has been written to
-    split_shmem->encoders.checksum = crc8(encoder_state, sizeof(encoder_state));
+    split_shmem->encoders.checksum = crc16(encoder_state, sizeof(encoder_state));
 }
 
 // clang-format off
@@ -260,36 +721,23 @@ static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sl
 
 #ifndef DISABLE_SYNC_TIMER
 
-static bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_update = 0;
-
-    bool okay = true;
-    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
-        uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
-        okay &= transport_write(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
-        if (okay) {
-            last_update = timer_read32();
-        }
-    }
-    return okay;
-}
+static void sync_timer_snapshot(void *state) { *(uint32_t *)state = sync_timer_read32() + SYNC_TIMER_OFFSET; }
 
-static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static void sync_timer_apply(const void *state) {
     static uint32_t last_sync_timer = 0;
-    if (last_sync_timer != split_shmem->sync_timer) {
-        last_sync_timer = split_shmem->sync_timer;
+    if (last_sync_timer != *(const uint32_t *)state) {
+        last_sync_timer = *(const uint32_t *)state;
         sync_timer_update(last_sync_timer);
     }
 }
 
-#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer_handlers)
-#    define TRANSACTIONS_SYNC_TIMER_SLAVE() TRANSACTION_HANDLER_SLAVE(sync_timer_handlers)
+// The timer changes all the time, it's only kept in sync periodically
+#    define TRANSACTIONS_SYNC_TIMER_STATES {PUT_SYNC_TIMER, SPLIT_SYNC_PERIODIC, FORCED_SYNC_THROTTLE_MS, sync_timer_snapshot, sync_timer_apply},
 #    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_initiator2target_initializer(sync_timer),
 
 #else  // DISABLE_SYNC_TIMER
 
-#    define TRANSACTIONS_SYNC_TIMER_MASTER()
-#    define TRANSACTIONS_SYNC_TIMER_SLAVE()
+#    define TRANSACTIONS_SYNC_TIMER_STATES
 #    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
 
 #endif  // DISABLE_SYNC_TIMER
@@ -299,25 +747,18 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
-static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_layer_state_update         = 0;
-    static uint32_t last_default_layer_state_update = 0;
+static void layer_state_snapshot(void *state) { *(layer_state_t *)state = layer_state; }
 
-    bool okay = send_if_condition(PUT_LAYER_STATE, &last_layer_state_update, (layer_state != split_shmem->layers.layer_state), &layer_state, sizeof(layer_state));
-    if (okay) {
-        okay &= send_if_condition(PUT_DEFAULT_LAYER_STATE, &last_default_layer_state_update, (default_layer_state != split_shmem->layers.default_layer_state), &default_layer_state, sizeof(default_layer_state));
-    }
-    return okay;
-}
+static void layer_state_apply(const void *state) { layer_state = *(const layer_state_t *)state; }
 
-static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    layer_state         = split_shmem->layers.layer_state;
-    default_layer_state = split_shmem->layers.default_layer_state;
-}
+static void default_layer_state_snapshot(void *state) { *(layer_state_t *)state = default_layer_state; }
+
+static void default_layer_state_apply(const void *state) { default_layer_state = *(const layer_state_t *)state; }
 
 // clang-format off
-#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state_handlers)
-#    define TRANSACTIONS_LAYER_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE(layer_state_handlers)
+#    define TRANSACTIONS_LAYER_STATE_STATES \
+    {PUT_LAYER_STATE,         SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, layer_state_snapshot,         layer_state_apply}, \
+    {PUT_DEFAULT_LAYER_STATE, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, default_layer_state_snapshot, default_layer_state_apply},
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
     [PUT_LAYER_STATE]         = trans_initiator2target_initializer(layers.layer_state), \
     [PUT_DEFAULT_LAYER_STATE] = trans_initiator2target_initializer(layers.default_layer_state),
@@ -325,8 +766,7 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #else  // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
-#    define TRANSACTIONS_LAYER_STATE_MASTER()
-#    define TRANSACTIONS_LAYER_STATE_SLAVE()
+#    define TRANSACTIONS_LAYER_STATE_STATES
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS
 
 #endif  // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
@@ -336,25 +776,19 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #ifdef SPLIT_LED_STATE_ENABLE
 
-static bool led_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_update = 0;
-    uint8_t         led_state   = host_keyboard_leds();
-    return send_if_data_mismatch(PUT_LED_STATE, &last_update, &led_state, &split_shmem->led_state, sizeof(led_state));
-}
+static void led_state_snapshot(void *state) { *(uint8_t *)state = host_keyboard_leds(); }
 
-static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static void led_state_apply(const void *state) {
     void set_split_host_keyboard_leds(uint8_t led_state);
-    set_split_host_keyboard_leds(split_shmem->led_state);
+    set_split_host_keyboard_leds(*(const uint8_t *)state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state_handlers)
-#    define TRANSACTIONS_LED_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE(led_state_handlers)
+#    define TRANSACTIONS_LED_STATE_STATES {PUT_LED_STATE, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, led_state_snapshot, led_state_apply},
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
 
 #else  // SPLIT_LED_STATE_ENABLE
 
-#    define TRANSACTIONS_LED_STATE_MASTER()
-#    define TRANSACTIONS_LED_STATE_SLAVE()
+#    define TRANSACTIONS_LED_STATE_STATES
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS
 
 #endif  // SPLIT_LED_STATE_ENABLE
@@ -364,54 +798,30 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #ifdef SPLIT_MODS_ENABLE
 
-static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t   last_update    = 0;
-    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
-    split_mods_sync_t new_mods;
-    new_mods.real_mods = get_mods();
-    if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
-        mods_need_sync = true;
-    }
-
-    new_mods.weak_mods = get_weak_mods();
-    if (!mods_need_sync && new_mods.weak_mods != split_shmem->mods.weak_mods) {
-        mods_need_sync = true;
-    }
-
+static void mods_snapshot(void *state) {
+    split_mods_sync_t *mods = state;
+    mods->real_mods         = get_mods();
+    mods->weak_mods         = get_weak_mods();
 #    ifndef NO_ACTION_ONESHOT
-    new_mods.oneshot_mods = get_oneshot_mods();
-    if (!mods_need_sync && new_mods.oneshot_mods != split_shmem->mods.oneshot_mods) {
-        mods_need_sync = true;
-    }
+    mods->oneshot_mods = get_oneshot_mods();
 #    endif  // NO_ACTION_ONESHOT
-
-    bool okay = true;
-    if (mods_need_sync) {
-        okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
-        if (okay) {
-            last_update = timer_read32();
-        }
-    }
-
-    return okay;
 }
 
-static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    set_mods(split_shmem->mods.real_mods);
-    set_weak_mods(split_shmem->mods.weak_mods);
+static void mods_apply(const void *state) {
+    const split_mods_sync_t *mods = state;
+    set_mods(mods->real_mods);
+    set_weak_mods(mods->weak_mods);
 #    ifndef NO_ACTION_ONESHOT
-    set_oneshot_mods(split_shmem->mods.oneshot_mods);
-#    endif
+    set_oneshot_mods(mods->oneshot_mods);
+#    endif  // NO_ACTION_ONESHOT
 }
 
-#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER(mods_handlers)
-#    define TRANSACTIONS_MODS_SLAVE() TRANSACTION_HANDLER_SLAVE(mods_handlers)
+#    define TRANSACTIONS_MODS_STATES {PUT_MODS, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, mods_snapshot, mods_apply},
 #    define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer(mods),
 
 #else  // SPLIT_MODS_ENABLE
 
-#    define TRANSACTIONS_MODS_MASTER()
-#    define TRANSACTIONS_MODS_SLAVE()
+#    define TRANSACTIONS_MODS_STATES
 #    define TRANSACTIONS_MODS_REGISTRATIONS
 
 #endif  // SPLIT_MODS_ENABLE
@@ -421,22 +831,16 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #ifdef BACKLIGHT_ENABLE
 
-static bool backlight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_update = 0;
-    uint8_t         level       = is_backlight_enabled() ? get_backlight_level() : 0;
-    return send_if_condition(PUT_BACKLIGHT, &last_update, (level != split_shmem->backlight_level), &level, sizeof(level));
-}
+static void backlight_snapshot(void *state) { *(uint8_t *)state = is_backlight_enabled() ? get_backlight_level() : 0; }
 
-static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { backlight_set(split_shmem->backlight_level); }
+static void backlight_apply(const void *state) { backlight_set(*(const uint8_t *)state); }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(backlight_handlers)
-#    define TRANSACTIONS_BACKLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(backlight_handlers)
+#    define TRANSACTIONS_BACKLIGHT_STATES {PUT_BACKLIGHT, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, backlight_snapshot, backlight_apply},
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
 
 #else  // BACKLIGHT_ENABLE
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER()
-#    define TRANSACTIONS_BACKLIGHT_SLAVE()
+#    define TRANSACTIONS_BACKLIGHT_STATES
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS
 
 #endif  // BACKLIGHT_ENABLE
@@ -467,7 +871,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 }
 
 #    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight_handlers)
-#    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight_handlers)
+#    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE_BATCHED(rgblight_handlers)
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
 
 #else  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
@@ -483,86 +887,425 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
-static bool led_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t   last_update = 0;
-    led_matrix_sync_t led_matrix_sync;
-    memcpy(&led_matrix_sync.led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
-    led_matrix_sync.led_suspend_state = led_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_LED_MATRIX, &last_update, &led_matrix_sync, &split_shmem->led_matrix_sync, sizeof(led_matrix_sync));
+static void led_matrix_snapshot(void *state) {
+    led_matrix_sync_t *led_matrix_sync = state;
+    memcpy(&led_matrix_sync->led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
+    led_matrix_sync->led_suspend_state = led_matrix_get_suspend_state();
 }
 
-static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    memcpy(&led_matrix_eeconfig, &split_shmem->led_matrix_sync.led_matrix, sizeof(led_eeconfig_t));
-    led_matrix_set_suspend_state(split_shmem->led_matrix_sync.led_suspend_state);
+static void led_matrix_apply(const void *state) {
+    const led_matrix_sync_t *led_matrix_sync = state;
+    memcpy(&led_matrix_eeconfig, &led_matrix_sync->led_matrix, sizeof(led_eeconfig_t));
+    led_matrix_set_suspend_state(led_matrix_sync->led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix_handlers)
-#    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix_handlers)
+#    define TRANSACTIONS_LED_MATRIX_STATES {PUT_LED_MATRIX, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, led_matrix_snapshot, led_matrix_apply},
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
 
 #else  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER()
-#    define TRANSACTIONS_LED_MATRIX_SLAVE()
+#    define TRANSACTIONS_LED_MATRIX_STATES
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS
 
 #endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
+////////////////////////////////////////////////////
+// LED Matrix hits
+
+#if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+
+static bool led_matrix_hits_take(void *data) {
+    split_led_matrix_hits_t *hits = data;
+    hits->count                   = led_matrix_split_hits_take(hits->hits, LED_HITS_TO_REMEMBER);
+    return hits->count > 0;
+}
+
+static bool led_matrix_hits_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static split_led_matrix_hits_t hits;
+    static split_acked_t           acked;
+    return send_acked(PUT_LED_MATRIX_HITS, GET_LED_MATRIX_HITS_ACK, &acked, &hits, sizeof(hits), led_matrix_hits_take);
+}
+
+static void led_matrix_hits_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t                 last_sequence = 0;
+    const split_led_matrix_hits_t *hits          = &split_shmem->led_matrix_hits;
+    if (receive_acked(hits, &last_sequence, &split_shmem->led_matrix_hits_ack)) {
+        led_matrix_split_hits_apply(hits->hits, hits->count < LED_HITS_TO_REMEMBER ? hits->count : LED_HITS_TO_REMEMBER);
+    }
+}
+
+#    define TRANSACTIONS_LED_MATRIX_HITS_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix_hits_handlers)
+#    define TRANSACTIONS_LED_MATRIX_HITS_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix_hits_handlers)
+// clang-format off
+#    define TRANSACTIONS_LED_MATRIX_HITS_REGISTRATIONS \
+    [PUT_LED_MATRIX_HITS]     = trans_bidirectional_initializer_cb(led_matrix_hits, led_matrix_hits_ack, NULL), \
+    [GET_LED_MATRIX_HITS_ACK] = trans_target2initiator_initializer(led_matrix_hits_ack),
+// clang-format on
+
+#else  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+
+#    define TRANSACTIONS_LED_MATRIX_HITS_MASTER()
+#    define TRANSACTIONS_LED_MATRIX_HITS_SLAVE()
+#    define TRANSACTIONS_LED_MATRIX_HITS_REGISTRATIONS
+
+#endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+
 ////////////////////////////////////////////////////
 // RGB Matrix
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
-static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t   last_update = 0;
-    rgb_matrix_sync_t rgb_matrix_sync;
-    memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
-    rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+static void rgb_matrix_snapshot(void *state) {
+    rgb_matrix_sync_t *rgb_matrix_sync = state;
+    memcpy(&rgb_matrix_sync->rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
+    rgb_matrix_sync->rgb_suspend_state = rgb_matrix_get_suspend_state();
 }
 
-static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
-    rgb_matrix_set_suspend_state(split_shmem->rgb_matrix_sync.rgb_suspend_state);
+static void rgb_matrix_apply(const void *state) {
+    const rgb_matrix_sync_t *rgb_matrix_sync = state;
+    memcpy(&rgb_matrix_config, &rgb_matrix_sync->rgb_matrix, sizeof(rgb_config_t));
+    rgb_matrix_set_suspend_state(rgb_matrix_sync->rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_handlers)
-#    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_handlers)
+#    define TRANSACTIONS_RGB_MATRIX_STATES {PUT_RGB_MATRIX, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, rgb_matrix_snapshot, rgb_matrix_apply},
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
 
 #else  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER()
-#    define TRANSACTIONS_RGB_MATRIX_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_STATES
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
 
 #endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+////////////////////////////////////////////////////
+// RGB Matrix hits
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+
+static bool rgb_matrix_hits_take(void *data) {
+    split_rgb_matrix_hits_t *hits = data;
+    hits->count                   = rgb_matrix_split_hits_take(hits->hits, LED_HITS_TO_REMEMBER);
+    return hits->count > 0;
+}
+
+static bool rgb_matrix_hits_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static split_rgb_matrix_hits_t hits;
+    static split_acked_t           acked;
+    return send_acked(PUT_RGB_MATRIX_HITS, GET_RGB_MATRIX_HITS_ACK, &acked, &hits, sizeof(hits), rgb_matrix_hits_take);
+}
+
+static void rgb_matrix_hits_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t                 last_sequence = 0;
+    const split_rgb_matrix_hits_t *hits          = &split_shmem->rgb_matrix_hits;
+    if (receive_acked(hits, &last_sequence, &split_shmem->rgb_matrix_hits_ack)) {
+        rgb_matrix_split_hits_apply(hits->hits, hits->count < LED_HITS_TO_REMEMBER ? hits->count : LED_HITS_TO_REMEMBER);
+    }
+}
+
+#    define TRANSACTIONS_RGB_MATRIX_HITS_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_hits_handlers)
+#    define TRANSACTIONS_RGB_MATRIX_HITS_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_hits_handlers)
+// clang-format off
+#    define TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS \
+    [PUT_RGB_MATRIX_HITS]     = trans_bidirectional_initializer_cb(rgb_matrix_hits, rgb_matrix_hits_ack, NULL), \
+    [GET_RGB_MATRIX_HITS_ACK] = trans_target2initiator_initializer(rgb_matrix_hits_ack),
+// clang-format on
+
+#else  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+
+#    define TRANSACTIONS_RGB_MATRIX_HITS_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_HITS_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS
+
+#endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+
+////////////////////////////////////////////////////
+// RGB Matrix LEDs
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+
+static bool rgb_matrix_leds_take(void *data) {
+    split_rgb_matrix_leds_t *leds = data;
+    leds->count                   = rgb_matrix_split_stream_take(leds->leds, RGB_MATRIX_SPLIT_STREAM_LEDS);
+    return leds->count > 0;
+}
+
+static bool rgb_matrix_leds_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static split_rgb_matrix_leds_t leds;
+    static split_acked_t           acked;
+    return send_acked(PUT_RGB_MATRIX_LEDS, GET_RGB_MATRIX_LEDS_ACK, &acked, &leds, sizeof(leds), rgb_matrix_leds_take);
+}
+
+static void rgb_matrix_leds_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t                 last_sequence = 0;
+    const split_rgb_matrix_leds_t *leds          = &split_shmem->rgb_matrix_leds;
+    if (receive_acked(leds, &last_sequence, &split_shmem->rgb_matrix_leds_ack)) {
+        rgb_matrix_split_stream_apply(leds->leds, leds->count < RGB_MATRIX_SPLIT_STREAM_LEDS ? leds->count : RGB_MATRIX_SPLIT_STREAM_LEDS);
+    }
+}
+
+#    define TRANSACTIONS_RGB_MATRIX_LEDS_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_leds_handlers)
+#    define TRANSACTIONS_RGB_MATRIX_LEDS_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_leds_handlers)
+// clang-format off
+#    define TRANSACTIONS_RGB_MATRIX_LEDS_REGISTRATIONS \
+    [PUT_RGB_MATRIX_LEDS]     = trans_bidirectional_initializer_cb(rgb_matrix_leds, rgb_matrix_leds_ack, NULL), \
+    [GET_RGB_MATRIX_LEDS_ACK] = trans_target2initiator_initializer(rgb_matrix_leds_ack),
+// clang-format on
+
+#else  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+
+#    define TRANSACTIONS_RGB_MATRIX_LEDS_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_LEDS_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_LEDS_REGISTRATIONS
+
+#endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+
 ////////////////////////////////////////////////////
 // WPM
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
-static bool wpm_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_update = 0;
-    uint8_t         current_wpm = get_current_wpm();
-    return send_if_condition(PUT_WPM, &last_update, (current_wpm != split_shmem->current_wpm), &current_wpm, sizeof(current_wpm));
-}
+static void wpm_snapshot(void *state) { *(uint8_t *)state = get_current_wpm(); }
 
-static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { set_current_wpm(split_shmem->current_wpm); }
+static void wpm_apply(const void *state) { set_current_wpm(*(const uint8_t *)state); }
 
-#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER(wpm_handlers)
-#    define TRANSACTIONS_WPM_SLAVE() TRANSACTION_HANDLER_SLAVE(wpm_handlers)
+#    define TRANSACTIONS_WPM_STATES {PUT_WPM, SPLIT_SYNC_ON_CHANGE, FORCED_SYNC_THROTTLE_MS, wpm_snapshot, wpm_apply},
 #    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
 
 #else  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
-#    define TRANSACTIONS_WPM_MASTER()
-#    define TRANSACTIONS_WPM_SLAVE()
+#    define TRANSACTIONS_WPM_STATES
 #    define TRANSACTIONS_WPM_REGISTRATIONS
 
 #endif  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+////////////////////////////////////////////////////
+// Replicated state
+
+static const split_sync_state_t split_sync_states[] = {
+    // clang-format off
+    TRANSACTIONS_SYNC_TIMER_STATES
+    TRANSACTIONS_LAYER_STATE_STATES
+    TRANSACTIONS_LED_STATE_STATES
+    TRANSACTIONS_MODS_STATES
+    TRANSACTIONS_BACKLIGHT_STATES
+    TRANSACTIONS_LED_MATRIX_STATES
+    TRANSACTIONS_RGB_MATRIX_STATES
+    TRANSACTIONS_WPM_STATES
+    // clang-format on
+    {-1},  // End of the table, so that it's never empty
+};
+
+#define NUM_SYNC_STATES (sizeof(split_sync_states) / sizeof(split_sync_states[0]) - 1)
+
+static bool sync_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_update[NUM_SYNC_STATES + 1];
+#if SPLIT_SYNC_WRITES_PER_SCAN > 0 && !defined(SPLIT_TRANSACTION_BATCH)
+    static uint8_t first  = 0;  // Where to start, so that every state gets its turn
+    uint8_t        writes = 0;
+#else
+    const uint8_t first = 0;
+#endif  // SPLIT_SYNC_WRITES_PER_SCAN > 0 && !defined(SPLIT_TRANSACTION_BATCH)
+
+    bool okay = true;
+    for (uint8_t n = 0; okay && n < NUM_SYNC_STATES; n++) {
+        uint8_t i = first + n;
+        if (i >= NUM_SYNC_STATES) {
+            i -= NUM_SYNC_STATES;
+        }
+
+        const split_sync_state_t *sync  = &split_sync_states[i];
+        split_transaction_desc_t *trans = &split_transaction_table[sync->transaction_id];
+        uint8_t                   state[trans->initiator2target_buffer_size];
+
+        // Zeroed first, so that padding doesn't show up as a change
+        memset(state, 0, sizeof(state));
+        sync->snapshot(state);
+        bool changed = sync->policy == SPLIT_SYNC_ON_CHANGE && memcmp(state, split_trans_initiator2target_buffer(trans), sizeof(state)) != 0;
+        if (!changed && timer_elapsed32(last_update[i]) < sync->throttle) {
+            continue;
+        }
+
+#if SPLIT_SYNC_WRITES_PER_SCAN > 0 && !defined(SPLIT_TRANSACTION_BATCH)
+        if (writes == SPLIT_SYNC_WRITES_PER_SCAN) {
+            // Out of writes for this scan, this state goes first next time
+            first = i;
+            break;
+        }
+        writes++;
+#endif  // SPLIT_SYNC_WRITES_PER_SCAN > 0 && !defined(SPLIT_TRANSACTION_BATCH)
+
+        okay &= transport_write(sync->transaction_id, state, sizeof(state));
+        if (okay) {
+            last_update[i] = timer_read32();
+        }
+    }
+    return okay;
+}
+
+static void sync_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    for (uint8_t i = 0; i < NUM_SYNC_STATES; i++) {
+        const split_sync_state_t *sync = &split_sync_states[i];
+        sync->apply(split_trans_initiator2target_buffer(&split_transaction_table[sync->transaction_id]));
+    }
+}
+
+////////////////////////////////////////////////////
+// Streams
+
+#ifdef SPLIT_STREAM_ENABLE
+
+#    define SPLIT_STREAM_FIRST_ID (GET_RPC_RESP_DATA + 1)
+#    define NUM_STREAM_IDS (NUM_TOTAL_TRANSACTIONS - SPLIT_STREAM_FIRST_ID)
+
+_Static_assert(sizeof(split_stream_fragment_t) <= UINT8_MAX, "SPLIT_STREAM_FRAGMENT_SIZE is too large");
+
+typedef struct _split_stream_rx_t {
+    uint8_t *               buffer;
+    uint16_t                size;
+    split_stream_callback_t callback;
+} split_stream_rx_t;
+
+// Master: the stream being sent
+static struct {
+    const uint8_t *     data;  // NULL when idle
+    uint16_t            total;
+    uint16_t            sent;   // offset of the next fragment to send
+    uint16_t            acked;  // length the slave has received so far
+    uint16_t            last_progress;
+    int8_t              transaction_id;
+    uint8_t             stream;
+    bool                reached;  // a fragment with this stream number has reached the slave
+    split_stream_done_t done;
+} stream_tx;
+
+// Slave: the registered receivers, and the stream being received
+static split_stream_rx_t stream_receivers[NUM_STREAM_IDS];
+static struct {
+    split_stream_rx_t *receiver;
+    uint16_t           total;
+    uint16_t           received;
+    uint8_t            stream;
+} stream_rx;
+
+// A new stream number tells the slave to start over, 0 is what the slave starts out with
+static void stream_next_number(void) {
+    if (++stream_tx.stream == 0) {
+        stream_tx.stream = 1;
+    }
+    stream_tx.reached = false;
+}
+
+static void stream_finish(bool success) {
+    split_stream_done_t done           = stream_tx.done;
+    int8_t              transaction_id = stream_tx.transaction_id;
+
+    stream_tx.data = NULL;
+    if (done) {
+        done(transaction_id, success);
+    }
+}
+
+static void stream_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    for (uint8_t n = 0; n < SPLIT_STREAM_FRAGMENTS_PER_SCAN && stream_tx.data; n++) {
+        // Fragments are sent without waiting for the previous ones to be confirmed, as long as they fit in the window.
+        // Once the window is full, or everything has been sent, go back to the first fragment not confirmed yet.
+        if (stream_tx.sent >= stream_tx.total || stream_tx.sent - stream_tx.acked >= SPLIT_STREAM_WINDOW * SPLIT_STREAM_FRAGMENT_SIZE) {
+            stream_tx.sent = stream_tx.acked;
+        }
+
+        uint16_t                remaining = stream_tx.total - stream_tx.sent;
+        split_stream_fragment_t fragment  = {
+            .transaction_id = stream_tx.transaction_id,
+            .stream         = stream_tx.stream,
+            .total          = stream_tx.total,
+            .offset         = stream_tx.sent,
+            .length         = remaining < SPLIT_STREAM_FRAGMENT_SIZE ? remaining : SPLIT_STREAM_FRAGMENT_SIZE,
+        };
+        memcpy(fragment.data, &stream_tx.data[fragment.offset], fragment.length);
+
+        split_stream_ack_t ack;
+        if (transport_transaction(PUT_STREAM_FRAGMENT, &fragment, sizeof(fragment), &ack, sizeof(ack))) {
+            stream_tx.sent += fragment.length;
+            // The acknowledgement is from before the slave has seen this fragment
+            if (ack.stream != stream_tx.stream) {
+                stream_tx.reached = true;
+            } else if (!stream_tx.reached) {
+                // Left over from before the master started, the slave would take the fragments for the stream it has
+                stream_next_number();
+                stream_tx.sent  = 0;
+                stream_tx.acked = 0;
+                continue;
+            } else if (ack.received == SPLIT_STREAM_REJECTED) {
+                stream_finish(false);
+                break;
+            } else if (ack.received > stream_tx.acked && ack.received <= stream_tx.total) {
+                stream_tx.acked         = ack.received;
+                stream_tx.last_progress = timer_read();
+            }
+        }
+
+        if (stream_tx.acked == stream_tx.total) {
+            stream_finish(true);
+        } else if (timer_elapsed(stream_tx.last_progress) >= SPLIT_STREAM_TIMEOUT) {
+            dprintf("Stream %d timed out\n", stream_tx.transaction_id);
+            stream_finish(false);
+        }
+    }
+    if (stream_tx.data) {
+        keyboard_task_busy();
+    }
+}
+
+static void stream_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_stream_rx_t *complete = NULL;
+
+    ATOMIC_BLOCK_FORCEON {
+        const split_stream_fragment_t *fragment = &split_shmem->stream_fragment;
+        if (fragment->stream != stream_rx.stream) {
+            // A new stream, see whether it has somewhere to go
+            stream_rx.stream   = fragment->stream;
+            stream_rx.total    = fragment->total;
+            stream_rx.received = 0;
+            stream_rx.receiver = NULL;
+            if (fragment->transaction_id >= SPLIT_STREAM_FIRST_ID && fragment->transaction_id < NUM_TOTAL_TRANSACTIONS) {
+                stream_rx.receiver = &stream_receivers[fragment->transaction_id - SPLIT_STREAM_FIRST_ID];
+            }
+            if (!stream_rx.receiver || !stream_rx.receiver->buffer || fragment->total > stream_rx.receiver->size) {
+                stream_rx.received = SPLIT_STREAM_REJECTED;
+            }
+        }
+
+        // Only take the fragment that comes next, anything else is a repeat or comes after a lost one
+        if (stream_rx.received != SPLIT_STREAM_REJECTED && fragment->offset == stream_rx.received && fragment->length > 0 && fragment->length <= SPLIT_STREAM_FRAGMENT_SIZE && fragment->length <= stream_rx.total - stream_rx.received) {
+            memcpy(&stream_rx.receiver->buffer[stream_rx.received], fragment->data, fragment->length);
+            stream_rx.received += fragment->length;
+            if (stream_rx.received == stream_rx.total) {
+                complete = stream_rx.receiver;
+            }
+        }
+
+        split_shmem->stream_ack.stream   = stream_rx.stream;
+        split_shmem->stream_ack.received = stream_rx.received;
+    }
+
+    // Outside of the atomic block, the callback may take a while
+    if (complete && complete->callback) {
+        complete->callback(stream_rx.total, complete->buffer);
+    }
+}
+
+#    define TRANSACTIONS_STREAM_MASTER() stream_handlers_master(master_matrix, slave_matrix)
+#    define TRANSACTIONS_STREAM_SLAVE() stream_handlers_slave(master_matrix, slave_matrix)
+#    define TRANSACTIONS_STREAM_REGISTRATIONS [PUT_STREAM_FRAGMENT] = trans_bidirectional_initializer_cb(stream_fragment, stream_ack, NULL),
+
+#else  // SPLIT_STREAM_ENABLE
+
+#    define TRANSACTIONS_STREAM_MASTER()
+#    define TRANSACTIONS_STREAM_SLAVE()
+#    define TRANSACTIONS_STREAM_REGISTRATIONS
+
+#endif  // SPLIT_STREAM_ENABLE
+
 ////////////////////////////////////////////////////
 
 uint8_t                  dummy;
@@ -585,8 +1328,12 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_BACKLIGHT_REGISTRATIONS
     TRANSACTIONS_RGBLIGHT_REGISTRATIONS
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
+    TRANSACTIONS_LED_MATRIX_HITS_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_LEDS_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
+    TRANSACTIONS_STREAM_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -599,36 +1346,114 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     bool okay = true;
+#ifdef SERIAL_USART_ASYNC
+    // Collect the slave matrix requested at the end of the last scan
+    TRANSACTIONS_SLAVE_MATRIX_COLLECT();
+    if (slave_matrix_in_flight) {
+        // The transport is still busy with the request, everything else waits for the next scan
+        keyboard_task_busy();
+        return okay;
+    }
+#elif !defined(SPLIT_TRANSACTION_BATCH)
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
-    TRANSACTIONS_MASTER_MATRIX_MASTER();
+#endif  // SERIAL_USART_ASYNC
+#if defined(SERIAL_USART_ASYNC) || !defined(SPLIT_TRANSACTION_BATCH)
+    // Before the next slave matrix request is posted, so the transport is free
     TRANSACTIONS_ENCODERS_MASTER();
-    TRANSACTIONS_SYNC_TIMER_MASTER();
-    TRANSACTIONS_LAYER_STATE_MASTER();
-    TRANSACTIONS_LED_STATE_MASTER();
-    TRANSACTIONS_MODS_MASTER();
-    TRANSACTIONS_BACKLIGHT_MASTER();
+#endif  // defined(SERIAL_USART_ASYNC) || !defined(SPLIT_TRANSACTION_BATCH)
+
+#ifdef SPLIT_TRANSACTION_BATCH
+    // Stage the writes, they are sent along with the slave matrix request
+    batch_staging = true;
+#endif  // SPLIT_TRANSACTION_BATCH
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTION_HANDLER_MASTER(sync_state_handlers);
     TRANSACTIONS_RGBLIGHT_MASTER();
-    TRANSACTIONS_LED_MATRIX_MASTER();
-    TRANSACTIONS_RGB_MATRIX_MASTER();
-    TRANSACTIONS_WPM_MASTER();
+#ifdef SPLIT_TRANSACTION_BATCH
+    batch_staging = false;
+#endif  // SPLIT_TRANSACTION_BATCH
+    TRANSACTIONS_LED_MATRIX_HITS_MASTER();
+    TRANSACTIONS_RGB_MATRIX_HITS_MASTER();
+    TRANSACTIONS_RGB_MATRIX_LEDS_MASTER();
+    TRANSACTIONS_STREAM_MASTER();
+
+#ifdef SERIAL_USART_ASYNC
+    // Request the slave matrix for the next scan
+    TRANSACTIONS_SLAVE_MATRIX_POST();
+#elif defined(SPLIT_TRANSACTION_BATCH)
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+#endif  // SERIAL_USART_ASYNC
     return okay;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    // The batch to apply. If another one arrives in the meantime, the rest waits for the next call.
+    uint8_t batch_sequence;
+    ATOMIC_BLOCK_FORCEON { batch_sequence = batch_accepted; };
+#endif  // SPLIT_TRANSACTION_BATCH
+
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
-    TRANSACTIONS_SYNC_TIMER_SLAVE();
-    TRANSACTIONS_LAYER_STATE_SLAVE();
-    TRANSACTIONS_LED_STATE_SLAVE();
-    TRANSACTIONS_MODS_SLAVE();
-    TRANSACTIONS_BACKLIGHT_SLAVE();
+    TRANSACTION_HANDLER_SLAVE_BATCHED(sync_state_handlers);
     TRANSACTIONS_RGBLIGHT_SLAVE();
-    TRANSACTIONS_LED_MATRIX_SLAVE();
-    TRANSACTIONS_RGB_MATRIX_SLAVE();
-    TRANSACTIONS_WPM_SLAVE();
+#ifdef SPLIT_TRANSACTION_BATCH
+    if (batch_sequence != 0) {
+        batch_applied = batch_sequence;
+    }
+#endif  // SPLIT_TRANSACTION_BATCH
+    TRANSACTIONS_LED_MATRIX_HITS_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_HITS_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_LEDS_SLAVE();
+    TRANSACTIONS_STREAM_SLAVE();
+}
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+const split_link_stats_t *split_link_stats(void) {
+    link_stats.quality = link_quality;
+    return &link_stats;
+}
+
+void split_link_stats_clear(void) { memset(&link_stats, 0, sizeof(link_stats)); }
+
+void split_link_stats_print(void) {
+    const split_link_stats_t *stats = split_link_stats();
+
+    xprintf("split link quality: %u/%u, retries: %u, failures: %u\n", stats->quality, UINT8_MAX, stats->retries, stats->failures);
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        if (stats->transactions[id]) {
+            xprintf("  transaction %2u: %5u sent, %5u failed\n", id, stats->transactions[id], stats->errors[id]);
+        }
+    }
+    print("  latency (ms):");
+    for (uint8_t bucket = 0; bucket < SPLIT_LINK_STATS_LATENCY_BUCKETS; bucket++) {
+        xprintf(" %s%u: %u", bucket == SPLIT_LINK_STATS_LATENCY_BUCKETS - 1 ? ">=" : "<", 1U << (bucket == SPLIT_LINK_STATS_LATENCY_BUCKETS - 1 ? bucket - 1 : bucket), stats->latency[bucket]);
+    }
+    print("\n");
+}
+
+void split_link_stats_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 3) {
+        return;
+    }
+
+    const uint8_t *stats  = (const uint8_t *)split_link_stats();
+    uint8_t        offset = data[1];
+    uint8_t        size   = length - 2;
+    memset(&data[2], 0, size);
+    if (offset < sizeof(split_link_stats_t)) {
+        if (size > sizeof(split_link_stats_t) - offset) {
+            size = sizeof(split_link_stats_t) - offset;
+        }
+        memcpy(&data[2], &stats[offset], size);
+    }
 }
 
+#endif  // SPLIT_LINK_STATS_ENABLE
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback) {
@@ -697,3 +1522,38 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 }
 
 #endif  // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#ifdef SPLIT_STREAM_ENABLE
+
+void transaction_register_stream(int8_t transaction_id, void *buffer, uint16_t size, split_stream_callback_t callback) {
+    // Streams use the RPC transaction IDs
+    if (transaction_id < SPLIT_STREAM_FIRST_ID || transaction_id >= NUM_TOTAL_TRANSACTIONS) return;
+
+    ATOMIC_BLOCK_FORCEON {
+        split_stream_rx_t *receiver = &stream_receivers[transaction_id - SPLIT_STREAM_FIRST_ID];
+        receiver->buffer            = buffer;
+        receiver->size              = size < SPLIT_STREAM_REJECTED ? size : SPLIT_STREAM_REJECTED - 1;
+        receiver->callback          = callback;
+    }
+}
+
+bool transaction_stream_send(int8_t transaction_id, uint16_t length, const void *data, split_stream_done_t done) {
+    // Streams use the RPC transaction IDs
+    if (transaction_id < SPLIT_STREAM_FIRST_ID || transaction_id >= NUM_TOTAL_TRANSACTIONS) return false;
+    if (length == 0 || length == SPLIT_STREAM_REJECTED || !data) return false;
+    if (transaction_stream_busy()) return false;
+
+    stream_next_number();
+    stream_tx.transaction_id = transaction_id;
+    stream_tx.total          = length;
+    stream_tx.sent           = 0;
+    stream_tx.acked          = 0;
+    stream_tx.last_progress  = timer_read();
+    stream_tx.done           = done;
+    stream_tx.data           = data;
+    return true;
+}
+
+bool transaction_stream_busy(void) { return stream_tx.data != NULL; }
+
+#endif  // SPLIT_STREAM_ENABLE
@@ -46,9 +46,43 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+#ifdef SPLIT_LINK_STATS_ENABLE
+#    define SPLIT_LINK_STATS_LATENCY_BUCKETS 8
+
+// Split link statistics, counters stop at UINT16_MAX
+typedef struct _split_link_stats_t {
+    uint16_t transactions[NUM_TOTAL_TRANSACTIONS];       // transport transactions, by transaction id
+    uint16_t errors[NUM_TOTAL_TRANSACTIONS];             // failed transport transactions, by transaction id
+    uint16_t latency[SPLIT_LINK_STATS_LATENCY_BUCKETS];  // successful transport transactions, taking <1ms, <2ms, <4ms ... >=64ms
+    uint16_t retries;                                    // built-in transactions that had to be retried
+    uint16_t failures;                                   // built-in transactions that ran out of attempts
+    uint8_t  quality;                                    // recent success rate, UINT8_MAX when nothing fails
+} split_link_stats_t;
+
+const split_link_stats_t *split_link_stats(void);
+void                      split_link_stats_clear(void);
+void                      split_link_stats_print(void);
+// fills data[2] onwards with the statistics, starting at the byte offset in data[1]
+void split_link_stats_raw_hid(uint8_t *data, uint8_t length);
+#endif  // SPLIT_LINK_STATS_ENABLE
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_STREAM_ENABLE
+// Called on the slave with the whole stream, once it has been received
+typedef void (*split_stream_callback_t)(uint16_t length, const void *data);
+// Called on the master once the slave has received the whole stream, or it has been given up on
+typedef void (*split_stream_done_t)(int8_t transaction_id, bool success);
+
+// slave: receive streams for transaction_id of up to size bytes into buffer
+void transaction_register_stream(int8_t transaction_id, void *buffer, uint16_t size, split_stream_callback_t callback);
+// master: start sending a stream, data must stay valid until done is called
+// returns false if another stream is still being sent
+bool transaction_stream_send(int8_t transaction_id, uint16_t length, const void *data, split_stream_done_t done);
+bool transaction_stream_busy(void);
+#endif  // SPLIT_STREAM_ENABLE
@@ -24,6 +24,10 @@
 
 #ifdef USE_I2C
 
+#    ifdef SERIAL_USART_ASYNC
+#        error "SERIAL_USART_ASYNC is only supported by the serial USART split transport"
+#    endif  // SERIAL_USART_ASYNC
+
 #    ifndef SLAVE_I2C_TIMEOUT
 #        define SLAVE_I2C_TIMEOUT 100
 #    endif  // SLAVE_I2C_TIMEOUT
@@ -60,7 +64,8 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
-        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+        // the data may already be in place in shared memory
+        memmove(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
         if ((status = i2c_writeReg(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
             return false;
         }
@@ -96,7 +101,8 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
-        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+        // the data may already be in place in shared memory
+        memmove(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
     if (soft_serial_transaction(id) != TRANSACTION_END) {
@@ -111,6 +117,53 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SERIAL_USART_ASYNC
+static int8_t posted_id = -1;
+
+bool transport_post_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    if (posted_id >= 0) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        // the data may already be in place in shared memory
+        memmove(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    if (!soft_serial_transaction_post(id)) {
+        return false;
+    }
+    posted_id = id;
+    return true;
+}
+
+transport_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length, bool wait) {
+    if (posted_id < 0) {
+        return TRANSPORT_FAILED;
+    }
+
+    int status = soft_serial_transaction_poll(wait);
+    if (status == TRANSACTION_PENDING) {
+        return TRANSPORT_PENDING;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[posted_id];
+    posted_id                       = -1;
+    if (status != TRANSACTION_END) {
+        return TRANSPORT_FAILED;
+    }
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return TRANSPORT_SUCCESS;
+}
+#    endif  // SERIAL_USART_ASYNC
+
 #endif  // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { return transactions_master(master_matrix, slave_matrix); }
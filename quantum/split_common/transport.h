@@ -31,6 +31,16 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif  // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_STREAM_ENABLE
+#    if !defined(SPLIT_TRANSACTION_IDS_KB) && !defined(SPLIT_TRANSACTION_IDS_USER)
+#        error "SPLIT_STREAM_ENABLE needs SPLIT_TRANSACTION_IDS_KB or SPLIT_TRANSACTION_IDS_USER"
+#    endif
+
+#    ifndef SPLIT_STREAM_FRAGMENT_SIZE
+#        define SPLIT_STREAM_FRAGMENT_SIZE 32
+#    endif  // SPLIT_STREAM_FRAGMENT_SIZE
+#endif      // SPLIT_STREAM_ENABLE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +50,15 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SERIAL_USART_ASYNC
+typedef enum { TRANSPORT_PENDING, TRANSPORT_SUCCESS, TRANSPORT_FAILED } transport_status_t;
+
+// starts a transaction in the background, returns false if the previous one hasn't been polled yet
+bool transport_post_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+// returns TRANSPORT_PENDING until the posted transaction is done, unless asked to wait for it
+transport_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length, bool wait);
+#endif  // SERIAL_USART_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #    define NUMBER_OF_ENCODERS (sizeof((pin_t[])ENCODERS_PAD_A) / sizeof(pin_t))
@@ -53,11 +72,24 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif  // RGBLIGHT_ENABLE
 
+#ifndef SPLIT_MATRIX_DELTA_ROWS
+#    define SPLIT_MATRIX_DELTA_ROWS 2
+#endif  // SPLIT_MATRIX_DELTA_ROWS
+
+#define SPLIT_MATRIX_DELTA_RESYNC 0xFF
+
 typedef struct _split_slave_matrix_sync_t {
-    uint8_t      checksum;
+    uint16_t     checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+typedef struct _split_slave_matrix_delta_t {
+    uint16_t     checksum;                         // of the whole slave matrix, once the delta is applied
+    uint8_t      count;                            // number of changed rows, or SPLIT_MATRIX_DELTA_RESYNC
+    uint8_t      rows[SPLIT_MATRIX_DELTA_ROWS];    // index of each changed row
+    matrix_row_t values[SPLIT_MATRIX_DELTA_ROWS];  // new state of each changed row
+} split_slave_matrix_delta_t;
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -66,11 +98,27 @@ typedef struct _split_master_matrix_sync_t {
 
 #ifdef ENCODER_ENABLE
 typedef struct _split_slave_encoder_sync_t {
-    uint8_t checksum;
-    uint8_t state[NUMBER_OF_ENCODERS];
+    uint16_t checksum;
+    uint8_t  state[NUMBER_OF_ENCODERS];
 } split_slave_encoder_sync_t;
 #endif  // ENCODER_ENABLE
 
+typedef struct _split_slave_reply_t {
+    split_slave_matrix_delta_t matrix;
+#if defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+    split_slave_encoder_sync_t encoders;
+#endif  // defined(SPLIT_TRANSACTION_BATCH) && defined(ENCODER_ENABLE)
+    uint8_t  sequence;  // incremented with every reply, so that the master can tell a stale one
+    uint16_t crc;       // of the whole reply up to here
+} split_slave_reply_t;
+
+#ifdef SPLIT_TRANSACTION_BATCH
+typedef struct _split_batch_trailer_t {
+    uint8_t  sequence;  // changes with every new batch, never 0
+    uint16_t crc;       // of the whole batch up to here
+} split_batch_trailer_t;
+#endif  // SPLIT_TRANSACTION_BATCH
+
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 typedef struct _split_layers_sync_t {
     layer_state_t layer_state;
@@ -85,7 +133,15 @@ typedef struct _led_matrix_sync_t {
     led_eeconfig_t led_matrix;
     bool           led_suspend_state;
 } led_matrix_sync_t;
-#endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+
+#    ifdef LED_MATRIX_SPLIT_HITS
+typedef struct _split_led_matrix_hits_t {
+    uint8_t         sequence;  // changes with every set of hits, never 0
+    uint8_t         count;
+    led_split_hit_t hits[LED_HITS_TO_REMEMBER];
+} split_led_matrix_hits_t;
+#    endif  // LED_MATRIX_SPLIT_HITS
+#endif      // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 #    include "rgb_matrix.h"
@@ -94,7 +150,23 @@ typedef struct _rgb_matrix_sync_t {
     rgb_config_t rgb_matrix;
     bool         rgb_suspend_state;
 } rgb_matrix_sync_t;
-#endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+
+#    ifdef RGB_MATRIX_SPLIT_HITS
+typedef struct _split_rgb_matrix_hits_t {
+    uint8_t         sequence;  // changes with every set of hits, never 0
+    uint8_t         count;
+    rgb_split_hit_t hits[LED_HITS_TO_REMEMBER];
+} split_rgb_matrix_hits_t;
+#    endif  // RGB_MATRIX_SPLIT_HITS
+
+#    ifdef RGB_MATRIX_SPLIT_STREAM
+typedef struct _split_rgb_matrix_leds_t {
+    uint8_t         sequence;  // changes with every set of LEDs, never 0
+    uint8_t         count;
+    rgb_split_led_t leds[RGB_MATRIX_SPLIT_STREAM_LEDS];
+} split_rgb_matrix_leds_t;
+#    endif  // RGB_MATRIX_SPLIT_STREAM
+#endif      // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #ifdef SPLIT_MODS_ENABLE
 typedef struct _split_mods_sync_t {
@@ -114,21 +186,69 @@ typedef struct _rpc_sync_info_t {
 } rpc_sync_info_t;
 #endif  // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_STREAM_ENABLE
+typedef struct _split_stream_fragment_t {
+    int8_t   transaction_id;
+    uint8_t  stream;  // changes with every stream, never 0
+    uint16_t total;   // length of the whole stream
+    uint16_t offset;  // of this fragment in the stream
+    uint8_t  length;  // of this fragment
+    uint8_t  data[SPLIT_STREAM_FRAGMENT_SIZE];
+} split_stream_fragment_t;
+
+#    define SPLIT_STREAM_REJECTED UINT16_MAX
+
+typedef struct _split_stream_ack_t {
+    uint8_t  stream;
+    uint16_t received;  // length of the stream received in order so far, SPLIT_STREAM_REJECTED if the slave can't take it
+} split_stream_ack_t;
+#endif  // SPLIT_STREAM_ENABLE
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
 #endif  // USE_I2C
 
     split_slave_matrix_sync_t smatrix;
-
-#ifdef SPLIT_TRANSPORT_MIRROR
-    split_master_matrix_sync_t mmatrix;
-#endif  // SPLIT_TRANSPORT_MIRROR
+    split_slave_reply_t       slave_reply;
 
 #ifdef ENCODER_ENABLE
     split_slave_encoder_sync_t encoders;
 #endif  // ENCODER_ENABLE
 
+#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    rpc_sync_info_t rpc_info;
+    uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
+    uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+#endif  // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#ifdef SPLIT_STREAM_ENABLE
+    split_stream_fragment_t stream_fragment;
+    split_stream_ack_t      stream_ack;
+#endif  // SPLIT_STREAM_ENABLE
+
+#if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+    split_led_matrix_hits_t led_matrix_hits;
+    uint8_t                 led_matrix_hits_ack;  // sequence of the last hits the slave has seen
+#endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT) && defined(LED_MATRIX_SPLIT_HITS)
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+    split_rgb_matrix_hits_t rgb_matrix_hits;
+    uint8_t                 rgb_matrix_hits_ack;  // sequence of the last hits the slave has seen
+#endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_HITS)
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+    split_rgb_matrix_leds_t rgb_matrix_leds;
+    uint8_t                 rgb_matrix_leds_ack;  // sequence of the last LEDs the slave has shown
+#endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_STREAM)
+
+    // Everything from here on is written by the master, and sent as one block when batching
+    uint16_t smatrix_base_checksum;  // checksum of the slave matrix the master holds
+
+#ifdef SPLIT_TRANSPORT_MIRROR
+    split_master_matrix_sync_t mmatrix;
+#endif  // SPLIT_TRANSPORT_MIRROR
+
 #ifndef DISABLE_SYNC_TIMER
     uint32_t sync_timer;
 #endif  // DISABLE_SYNC_TIMER
@@ -165,11 +285,9 @@ typedef struct _split_shared_memory_t {
     uint8_t current_wpm;
 #endif  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
-#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
-    rpc_sync_info_t rpc_info;
-    uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
-    uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
-#endif  // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#ifdef SPLIT_TRANSACTION_BATCH
+    split_batch_trailer_t batch_trailer;  // last, so that it covers everything before it in the batch
+#endif  // SPLIT_TRANSACTION_BATCH
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
\ No newline at end of file
@@ -0,0 +1,33 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "action.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECORDED_EVENTS_MAX 8
+
+// the key events seen by process_record_user(), in order
+extern keyevent_t recorded_events[RECORDED_EVENTS_MAX];
+extern uint8_t    recorded_events_count;
+
+#ifdef __cplusplus
+}
+#endif
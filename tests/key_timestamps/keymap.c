@@ -0,0 +1,36 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+#include "key_timestamps.h"
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] =
+        {
+            {KC_A, KC_B, KC_C, KC_D},
+            {KC_E, KC_F, KC_G, KC_H},
+        },
+};
+
+keyevent_t recorded_events[RECORDED_EVENTS_MAX];
+uint8_t    recorded_events_count;
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (recorded_events_count < RECORDED_EVENTS_MAX) {
+        recorded_events[recorded_events_count++] = record->event;
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "key_timestamps.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class KeyTimestamps : public TestFixture {
+   protected:
+    void expect_event(uint8_t index, uint8_t col, uint8_t row, bool pressed, uint16_t time) {
+        ASSERT_LT(index, recorded_events_count);
+        const keyevent_t &event = recorded_events[index];
+        EXPECT_EQ(event.key.col, col);
+        EXPECT_EQ(event.key.row, row);
+        EXPECT_EQ(event.pressed, pressed);
+        EXPECT_EQ(event.time, time);
+    }
+};
+
+TEST_F(KeyTimestamps, EventsAreProcessedOldestFirstWithTheirTransitionTime) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(0, 0);
+    press_key(1, 0);
+    idle_for(10);
+
+    recorded_events_count = 0;
+    set_time(1000);
+    // Releases are debounced, B is let go first but comes after A in the matrix
+    release_key(1, 0);
+    keyboard_task();
+    set_time(1002);
+    release_key(0, 0);
+    keyboard_task();
+    EXPECT_EQ(recorded_events_count, 0);
+
+    // The main loop stalls until both releases are done debouncing
+    set_time(1020);
+    keyboard_task();
+    ASSERT_EQ(recorded_events_count, 2);
+    expect_event(0, 1, 0, false, 1000 | 1);
+    expect_event(1, 0, 0, false, 1002 | 1);
+}
+
+TEST_F(KeyTimestamps, EventTimesStayInOrderWhenDebouncingHoldsAKeyBack) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    press_key(0, 0);
+    idle_for(10);
+
+    recorded_events_count = 0;
+    set_time(2000);
+    // The release of A is held back by debouncing, the press of B goes through eagerly
+    release_key(0, 0);
+    keyboard_task();
+    set_time(2002);
+    press_key(1, 1);
+    keyboard_task();
+    set_time(2006);
+    keyboard_task();
+
+    ASSERT_EQ(recorded_events_count, 2);
+    expect_event(0, 1, 1, true, 2002 | 1);
+    // A was released at 2000, but can't be reported as older than the press of B
+    expect_event(1, 0, 0, false, 2002 | 1);
+}
+
+TEST_F(KeyTimestamps, KeysOfADisconnectedHalfAreStampedReleased) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    set_time(3000);
+    press_key(0, 0);
+    press_key(2, 1);
+    idle_for(10);
+    EXPECT_EQ(matrix_get_key_time(0, 0), 3000);
+    EXPECT_EQ(matrix_get_key_time(1, 2), 3000);
+    const uint16_t untouched = matrix_get_key_time(1, 3);
+
+    // Row 1 is the other half, which disconnects with G still held
+    set_time(3100);
+    matrix_row_t other_half[] = {matrix_get_row(1)};
+    matrix_release_key_times(other_half, 1, 1);
+
+    EXPECT_EQ(matrix_get_key_time(1, 2), 3100);
+    EXPECT_EQ(matrix_get_key_time(1, 3), untouched);
+    EXPECT_EQ(matrix_get_key_time(0, 0), 3000);
+}
@@ -0,0 +1,54 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] =
+        {
+            {KC_A, KC_B, KC_C, KC_D},
+            {KC_E, KC_F, KC_G, KC_H},
+        },
+};
+
+led_config_t g_led_config = {{
+                                 // Key Matrix to LED Index
+                                 {0, 1, 2, 3},
+                                 {4, 5, 6, 7},
+                             },
+                             {
+                                 // LED Index to Physical Position
+                                 {0, 0}, {74, 0}, {149, 0}, {224, 0}, {0, 64}, {74, 64}, {149, 64}, {224, 64}
+                             },
+                             {
+                                 // LED Index to Flag
+                                 4, 4, 4, 4, 4, 4, 4, 4
+                             }};
+
+static void test_rgb_init(void) {}
+
+static void test_rgb_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+
+static void test_rgb_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void test_rgb_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_rgb_init,
+    .set_color     = test_rgb_set_color,
+    .set_color_all = test_rgb_set_color_all,
+    .flush         = test_rgb_flush,
+};
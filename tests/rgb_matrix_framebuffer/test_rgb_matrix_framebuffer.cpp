@@ -0,0 +1,63 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+static uint8_t switch_mode_mid_frame = RGB_MATRIX_NONE;
+
+// Changes the mode once the first LEDs of a frame are rendered, without going through
+// rgb_matrix_mode(), the way a slave half does when it copies the master's config
+extern "C" void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    if (switch_mode_mid_frame != RGB_MATRIX_NONE && led_min == 0) {
+        rgb_matrix_config.mode = switch_mode_mid_frame;
+        switch_mode_mid_frame  = RGB_MATRIX_NONE;
+    }
+}
+
+class RgbMatrixFramebuffer : public TestFixture {};
+
+TEST_F(RgbMatrixFramebuffer, ModeChangedMidFrameGetsAClearedFramebuffer) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    // Leave some heat behind in the framebuffer
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    ASSERT_NE(rgb_matrix_framebuffer(), nullptr);
+    press_key(0, 0);
+    run_one_scan_loop();
+    EXPECT_NE(static_cast<uint8_t *>(rgb_matrix_framebuffer())[0], 0);
+    release_key(0, 0);
+    run_one_scan_loop();
+
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    EXPECT_EQ(rgb_matrix_framebuffer(), nullptr);
+
+    switch_mode_mid_frame = RGB_MATRIX_TYPING_HEATMAP;
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    EXPECT_EQ(switch_mode_mid_frame, RGB_MATRIX_NONE);
+    EXPECT_EQ(rgb_matrix_get_mode(), RGB_MATRIX_TYPING_HEATMAP);
+
+    uint8_t *frame = static_cast<uint8_t *>(rgb_matrix_framebuffer());
+    ASSERT_NE(frame, nullptr);
+    for (uint8_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+        EXPECT_EQ(frame[i], 0) << "at " << +i;
+    }
+}
@@ -17,20 +17,49 @@
 #include "matrix.h"
 #include "test_matrix.h"
 #include <string.h>
+#ifdef DEBOUNCE
+#    include "debounce.h"
+#endif
 
 static matrix_row_t matrix[MATRIX_ROWS] = {};
 
+#if defined(MATRIX_KEY_TIMESTAMPS) || defined(DEBOUNCE)
+// the switches at the previous scan
+static matrix_row_t scanned[MATRIX_ROWS] = {};
+#endif
+#ifdef DEBOUNCE
+// Tests that configure DEBOUNCE get the switches through the debounce algorithm
+static matrix_row_t debounced[MATRIX_ROWS] = {};
+#endif
+
 void matrix_init(void) {
     clear_all_keys();
+#ifdef DEBOUNCE
+    debounce_init(MATRIX_ROWS);
+#endif
     matrix_init_quantum();
 }
 
 uint8_t matrix_scan(void) {
+#if defined(MATRIX_KEY_TIMESTAMPS) || defined(DEBOUNCE)
+    bool changed = memcmp(scanned, matrix, sizeof(matrix)) != 0;
+#    ifdef MATRIX_KEY_TIMESTAMPS
+    if (changed) matrix_update_key_times(scanned, matrix, 0, MATRIX_ROWS);
+#    endif
+    memcpy(scanned, matrix, sizeof(matrix));
+#endif
+#ifdef DEBOUNCE
+    debounce(matrix, debounced, MATRIX_ROWS, changed);
+#endif
     matrix_scan_quantum();
     return 1;
 }
 
+#ifdef DEBOUNCE
+matrix_row_t matrix_get_row(uint8_t row) { return debounced[row]; }
+#else
 matrix_row_t matrix_get_row(uint8_t row) { return matrix[row]; }
+#endif
 
 void matrix_print(void) {}
 
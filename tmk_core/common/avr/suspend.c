@@ -37,7 +37,7 @@
 
 /** \brief Suspend idle
  *
- * FIXME: needs doc
+ * Sleep until the next interrupt, which is the 1ms timer tick at the latest.
  */
 void suspend_idle(uint8_t time) {
     cli();
@@ -48,6 +48,29 @@ void suspend_idle(uint8_t time) {
     sleep_disable();
 }
 
+#ifdef MATRIX_IDLE_SLEEP
+#    if defined(PCICR) && defined(PCMSK0)
+// Only waking the MCU matters, the matrix scan picks up the change
+EMPTY_INTERRUPT(PCINT0_vect);
+#    endif
+
+/** \brief Enable a wakeup pin
+ *
+ * Called once for each matrix input by matrix_init(). Pin change interrupts are only
+ * available for port B on every supported MCU, false is returned for other pins.
+ */
+bool suspend_wakeup_pin_enable(pin_t pin) {
+#    if defined(PCICR) && defined(PCMSK0)
+    if ((pin >> PORT_SHIFTER) == PINB_ADDRESS) {
+        PCMSK0 |= _BV(pin & 0xF);
+        PCICR |= _BV(PCIE0);
+        return true;
+    }
+#    endif
+    return false;
+}
+#endif
+
 // TODO: This needs some cleanup
 
 /** \brief Run keyboard level Power down
@@ -124,6 +124,35 @@ inline uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(t, last);
 }
 
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_COMPARE_FLAG (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_COMPARE_FLAG (TIFR & _BV(OCF0A))
+#else
+#    define TIMER_COMPARE_FLAG (TIFR0 & _BV(OCF0A))
+#endif
+
+/** \brief timer read_us32
+ *
+ * Microseconds, as fine as one count of timer0
+ */
+uint32_t timer_read_us32(void) {
+    uint32_t t;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        t   = timer_count;
+        raw = TIMER_RAW;
+        // timer0 has started over, but its interrupt hasn't counted the millisecond yet
+        if (TIMER_COMPARE_FLAG && raw < TIMER_RAW_TOP / 2) {
+            t++;
+        }
+    }
+
+    // timer0 counts 0 to TIMER_RAW_TOP, inclusive, every millisecond
+    return t * 1000 + (uint32_t)raw * 1000 / (TIMER_RAW_TOP + 1);
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -41,6 +41,10 @@ typedef uint16_t port_data_t;
 
 #define readPort(pin) palReadPort(PAL_PORT(pin))
 
+/* Port of a pin, for comparison, and its bit in readPort() */
+#define getPinPort(pin) PAL_PORT(pin)
+#define getPinPortBit(pin) PAL_PAD(pin)
+
 #define setPortBitInput(pin, bit) palSetPadMode(PAL_PORT(pin), bit, PAL_MODE_INPUT)
 #define setPortBitInputHigh(pin, bit) palSetPadMode(PAL_PORT(pin), bit, PAL_MODE_INPUT_PULLUP)
 #define setPortBitInputLow(pin, bit) palSetPadMode(PAL_PORT(pin), bit, PAL_MODE_INPUT_PULLDOWN)
@@ -31,14 +31,64 @@
 #    include "rgb_matrix.h"
 #endif
 
+#ifdef MATRIX_IDLE_SLEEP
+static thread_reference_t idle_thread = NULL;
+
+#    if PAL_USE_CALLBACKS == TRUE
+static void wakeup_pin_cb(void *arg) {
+    (void)arg;
+    chSysLockFromISR();
+    chThdResumeI(&idle_thread, MSG_OK);
+    chSysUnlockFromISR();
+}
+#    endif
+#endif
+
 /** \brief suspend idle
  *
- * FIXME: needs doc
+ * Sleep until a wakeup pin changes, or for at most time milliseconds.
  */
 void suspend_idle(uint8_t time) {
-    // TODO: this is not used anywhere - what units is 'time' in?
+#ifdef MATRIX_IDLE_SLEEP
+    // The ChibiOS idle thread sleeps the MCU while this thread waits
+    chSysLock();
+    chThdSuspendTimeoutS(&idle_thread, TIME_MS2I(time));
+    chSysUnlock();
+#else
     wait_ms(time);
+#endif
+}
+
+#ifdef MATRIX_IDLE_SLEEP
+/** \brief Enable a wakeup pin
+ *
+ * Called once for each matrix input by matrix_init(). Needs PAL_USE_CALLBACKS in halconf.h,
+ * without it false is returned.
+ *
+ * Pins with the same pad number share an EXTI line, so false is returned for a pin when its
+ * line is already in use, by another driver or by an earlier pin, or when it shares it with
+ * SOFT_SERIAL_PIN, which the split transport on the slave needs to itself.
+ */
+bool suspend_wakeup_pin_enable(pin_t pin) {
+#    if PAL_USE_CALLBACKS == TRUE
+#        ifdef SOFT_SERIAL_PIN
+    if (PAL_PAD(pin) == PAL_PAD(SOFT_SERIAL_PIN)) {
+        return false;
+    }
+#        endif
+#        ifdef pal_lld_ispadeventenabled
+    if (palIsLineEventEnabled(pin)) {
+        return false;
+    }
+#        endif
+    palEnableLineEvent(pin, PAL_EVENT_MODE_FALLING_EDGE);
+    palSetLineCallback(pin, wakeup_pin_cb, NULL);
+    return true;
+#    else
+    return false;
+#    endif
 }
+#endif
 
 /** \brief Run keyboard level Power down
  *
@@ -20,7 +20,7 @@ void timer_clear(void) {
 
 uint16_t timer_read(void) { return (uint16_t)timer_read32(); }
 
-uint32_t timer_read32(void) {
+static uint32_t timer_read_ticks(void) {
     uint32_t systime = (uint32_t)chVTGetSystemTime();
 
 #if CH_CFG_ST_RESOLUTION < 32
@@ -36,12 +36,17 @@ uint32_t timer_read32(void) {
     }
 
     last_systime = systime;
-    return (uint32_t)TIME_I2MS(systime - reset_point + overflow);
+    return systime - reset_point + overflow;
 #else
-    return (uint32_t)TIME_I2MS(systime - reset_point);
+    return systime - reset_point;
 #endif
 }
 
+uint32_t timer_read32(void) { return (uint32_t)TIME_I2MS(timer_read_ticks()); }
+
+// As fine as CH_CFG_ST_FREQUENCY
+uint32_t timer_read_us32(void) { return (uint32_t)TIME_I2US(timer_read_ticks()); }
+
 uint16_t timer_elapsed(uint16_t last) { return TIMER_DIFF_16(timer_read(), last); }
 
 uint32_t timer_elapsed32(uint32_t last) { return TIMER_DIFF_32(timer_read32(), last); }
@@ -58,6 +58,10 @@ void eeconfig_init_quantum(void) {
     eeprom_update_byte(EECONFIG_VELOCIKEY, 0);
     eeprom_update_dword(EECONFIG_RGB_MATRIX, 0);
     eeprom_update_word(EECONFIG_RGB_MATRIX_EXTENDED, 0);
+#ifdef MATRIX_SETTLE_CALIBRATION
+    // not calibrated
+    eeprom_update_word(EECONFIG_MATRIX_SETTLE, 0);
+#endif
 
     // TODO: Remove once ARM has a way to configure EECONFIG_HANDEDNESS
     //        within the emulated eeprom via dfu-util or another tool
@@ -209,3 +213,25 @@ bool eeconfig_read_handedness(void) { return !!eeprom_read_byte(EECONFIG_HANDEDN
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) { eeprom_update_byte(EECONFIG_HANDEDNESS, !!val); }
+
+#ifdef MATRIX_SETTLE_CALIBRATION
+/** \brief eeconfig read matrix settle times
+ *
+ * Fills polls with EECONFIG_MATRIX_SETTLE_SIZE settle times, and returns false if the matrix hasn't been calibrated.
+ */
+bool eeconfig_read_matrix_settle(uint8_t *polls) {
+    if (eeprom_read_word(EECONFIG_MATRIX_SETTLE) != EECONFIG_MATRIX_SETTLE_MAGIC) {
+        return false;
+    }
+    eeprom_read_block(polls, EECONFIG_MATRIX_SETTLE_POLLS, EECONFIG_MATRIX_SETTLE_SIZE);
+    return true;
+}
+/** \brief eeconfig update matrix settle times
+ *
+ * Stores EECONFIG_MATRIX_SETTLE_SIZE settle times and marks the matrix as calibrated.
+ */
+void eeconfig_update_matrix_settle(const uint8_t *polls) {
+    eeprom_update_block(polls, EECONFIG_MATRIX_SETTLE_POLLS, EECONFIG_MATRIX_SETTLE_SIZE);
+    eeprom_update_word(EECONFIG_MATRIX_SETTLE, EECONFIG_MATRIX_SETTLE_MAGIC);
+}
+#endif
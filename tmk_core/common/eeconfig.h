@@ -21,7 +21,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdbool.h>
 
 #ifndef EECONFIG_MAGIC_NUMBER
-#    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEEA  // When changing, decrement this value to avoid future re-init issues
+#    ifdef MATRIX_SETTLE_CALIBRATION
+// The settle block moves everything stored past EECONFIG_SIZE (VIA, dynamic keymaps), so turning it on or off
+// starts over. Kept apart from the values the default number is decremented through.
+#        define EECONFIG_MAGIC_NUMBER (uint16_t)0x5EEA
+#    else
+#        define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEEA  // When changing, decrement this value to avoid future re-init issues
+#    endif
 #endif
 #define EECONFIG_MAGIC_NUMBER_OFF (uint16_t)0xFFFF
 
@@ -53,8 +59,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 // TODO: Combine these into a single word and single block of EEPROM
 #define EECONFIG_KEYMAP_UPPER_BYTE (uint8_t *)34
+#ifdef MATRIX_SETTLE_CALIBRATION
+// Matrix settle times, one byte per row (COL2ROW) or col (ROW2COL)
+#    define EECONFIG_MATRIX_SETTLE (uint16_t *)35
+#    define EECONFIG_MATRIX_SETTLE_POLLS (uint8_t *)37
+#    define EECONFIG_MATRIX_SETTLE_SIZE (MATRIX_ROWS > MATRIX_COLS ? MATRIX_ROWS : MATRIX_COLS)
 // Size of EEPROM being used, other code can refer to this for available EEPROM
-#define EECONFIG_SIZE 35
+#    define EECONFIG_SIZE (37 + EECONFIG_MATRIX_SETTLE_SIZE)
+#else
+// Size of EEPROM being used, other code can refer to this for available EEPROM
+#    define EECONFIG_SIZE 35
+#endif
+#ifdef MATRIX_SETTLE_CALIBRATION
+/* matrix settle: marks a valid calibration for this matrix size */
+#    define EECONFIG_MATRIX_SETTLE_MAGIC (uint16_t)(0x5E00 | EECONFIG_MATRIX_SETTLE_SIZE)
+/* matrix settle: line not calibrated, use the default delay */
+#    define EECONFIG_MATRIX_SETTLE_DEFAULT 0xFF
+#endif
+
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
@@ -111,3 +133,8 @@ void     eeconfig_update_haptic(uint32_t val);
 
 bool eeconfig_read_handedness(void);
 void eeconfig_update_handedness(bool val);
+
+#ifdef MATRIX_SETTLE_CALIBRATION
+bool eeconfig_read_matrix_settle(uint8_t *polls);
+void eeconfig_update_matrix_settle(const uint8_t *polls);
+#endif
@@ -126,24 +126,40 @@ void            last_encoder_activity_trigger(void) { last_encoder_modification_
 static uint32_t matrix_timer           = 0;
 static uint32_t matrix_scan_count      = 0;
 static uint32_t last_matrix_scan_count = 0;
+static uint16_t matrix_scan_max_keys      = 0;
+static uint16_t last_matrix_scan_max_keys = 0;
+static uint32_t matrix_task_max_time      = 0;
+static uint32_t last_matrix_task_max_time = 0;
 
-void matrix_scan_perf_task(void) {
+void matrix_scan_perf_task(uint16_t keys_processed, uint32_t task_time) {
     matrix_scan_count++;
+    if (keys_processed > matrix_scan_max_keys) {
+        matrix_scan_max_keys = keys_processed;
+    }
+    if (task_time > matrix_task_max_time) {
+        matrix_task_max_time = task_time;
+    }
 
     uint32_t timer_now = timer_read32();
     if (TIMER_DIFF_32(timer_now, matrix_timer) > 1000) {
 #    if defined(CONSOLE_ENABLE)
-        dprintf("matrix scan frequency: %lu\n", matrix_scan_count);
+        dprintf("matrix scan frequency: %lu, max keys per scan: %u, max key processing time: %luus\n", matrix_scan_count, matrix_scan_max_keys, matrix_task_max_time);
 #    endif
-        last_matrix_scan_count = matrix_scan_count;
-        matrix_timer           = timer_now;
-        matrix_scan_count      = 0;
+        last_matrix_scan_count    = matrix_scan_count;
+        last_matrix_scan_max_keys = matrix_scan_max_keys;
+        last_matrix_task_max_time = matrix_task_max_time;
+        matrix_timer              = timer_now;
+        matrix_scan_count         = 0;
+        matrix_scan_max_keys      = 0;
+        matrix_task_max_time      = 0;
     }
 }
 
 uint32_t get_matrix_scan_rate(void) { return last_matrix_scan_count; }
+uint16_t get_matrix_scan_max_keys(void) { return last_matrix_scan_max_keys; }
+uint32_t get_matrix_task_max_time(void) { return last_matrix_task_max_time; }
 #else
-#    define matrix_scan_perf_task()
+#    define matrix_scan_perf_task(keys_processed, task_time)
 #endif
 
 #ifdef MATRIX_HAS_GHOST
@@ -371,6 +387,154 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 #endif
 }
 
+#ifndef MATRIX_TASK_MAX_KEYS
+#    ifdef QMK_KEYS_PER_SCAN
+#        define MATRIX_TASK_MAX_KEYS QMK_KEYS_PER_SCAN
+#    else
+#        define MATRIX_TASK_MAX_KEYS 16
+#    endif
+#endif
+
+typedef struct {
+    keypos_t key;
+#ifdef MATRIX_KEY_TIMESTAMPS
+    uint16_t age;
+#endif
+} matrix_change_t;
+
+/** \brief matrix_collect_changes
+ *
+ * Goes through the changes once, and picks the ones to process in this pass, in the
+ * order to process them. Without MATRIX_KEY_TIMESTAMPS all changes happened at the
+ * time of the scan and the first ones in matrix order are taken, otherwise the oldest
+ * ones by transition time (matrix order on ties). Changes that don't fit are left for
+ * the next call.
+ *
+ * Returns the number of changes picked.
+ */
+static uint8_t matrix_collect_changes(const matrix_row_t changes[], uint16_t now, matrix_change_t picked[]) {
+    uint8_t count = 0;
+
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        if (!changes[r]) {
+            continue;
+        }
+        matrix_row_t col_mask = 1;
+        for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
+            if (!(changes[r] & col_mask)) {
+                continue;
+            }
+#ifdef MATRIX_KEY_TIMESTAMPS
+            uint16_t age = TIMER_DIFF_16(now, matrix_get_key_time(r, c));
+            if (count == MATRIX_TASK_MAX_KEYS) {
+                if (age <= picked[count - 1].age) {
+                    continue;
+                }
+                // takes the place of the newest change picked so far
+                count--;
+            }
+            // insert in order, oldest first
+            uint8_t i = count++;
+            for (; i > 0 && picked[i - 1].age < age; i--) {
+                picked[i] = picked[i - 1];
+            }
+            picked[i] = (matrix_change_t){.key = {.row = r, .col = c}, .age = age};
+#else
+            picked[count++] = (matrix_change_t){.key = {.row = r, .col = c}};
+            if (count == MATRIX_TASK_MAX_KEYS) {
+                return count;
+            }
+#endif
+        }
+    }
+
+    return count;
+}
+
+/** \brief matrix_event_time
+ *
+ * Returns the time to report for a key event. With MATRIX_KEY_TIMESTAMPS this is the
+ * time the switch changed rather than the time it is processed, so that the tapping
+ * code measures the real interval between keys even when the main loop is slow.
+ */
+static uint16_t matrix_event_time(keypos_t key, uint32_t now) {
+#ifdef MATRIX_KEY_TIMESTAMPS
+    static uint32_t last_event_time = 0;
+
+    uint32_t age = TIMER_DIFF_16((uint16_t)now, matrix_get_key_time(key.row, key.col));
+    // A key held back longer by debouncing must not be reported as older than an
+    // event that has already been processed, action_exec() expects events in order
+    if (TIMER_DIFF_32(now, last_event_time) < age) {
+        age = TIMER_DIFF_32(now, last_event_time);
+    }
+    last_event_time = now - age;
+
+    return (uint16_t)last_event_time | 1; /* time should not be 0 */
+#else
+    return (uint16_t)now | 1; /* time should not be 0 */
+#endif
+}
+
+/** \brief matrix_task
+ *
+ * Processes every key that changed state since the previous scan in a single pass,
+ * so chords and fast rolls no longer take one keyboard_task() iteration per key.
+ * Events are fed to action_exec() in the order of their transition time.
+ *
+ * At most MATRIX_TASK_MAX_KEYS events (QMK_KEYS_PER_SCAN if defined) are processed;
+ * the remaining changes stay pending in matrix_prev and are picked up by the next call.
+ *
+ * Returns the number of key events processed.
+ */
+static uint16_t matrix_task(void) {
+    static matrix_row_t matrix_prev[MATRIX_ROWS];
+    matrix_row_t        matrix_changes[MATRIX_ROWS];
+    bool                matrix_changed = false;
+
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        const matrix_row_t matrix_row = matrix_get_row(r);
+        matrix_changes[r]             = matrix_row ^ matrix_prev[r];
+#ifdef MATRIX_HAS_GHOST
+        if (matrix_changes[r] && has_ghost_in_row(r, matrix_row)) {
+            matrix_changes[r] = 0;
+        }
+#endif
+        matrix_changed |= (matrix_changes[r] != 0);
+    }
+
+    if (!matrix_changed) {
+        return 0;
+    }
+    if (debug_matrix) matrix_print();
+
+    const uint32_t  now          = timer_read32();
+    const bool      process_keys = should_process_keypress();
+    matrix_change_t changes[MATRIX_TASK_MAX_KEYS];
+    const uint8_t   count = matrix_collect_changes(matrix_changes, (uint16_t)now, changes);
+
+    for (uint8_t i = 0; i < count; i++) {
+        const keypos_t     key      = changes[i].key;
+        const matrix_row_t col_mask = MATRIX_ROW_SHIFTER << key.col;
+        const bool         pressed  = !(matrix_prev[key.row] & col_mask);
+
+        if (process_keys) {
+            action_exec((keyevent_t){.key = key, .pressed = pressed, .time = matrix_event_time(key, now)});
+        }
+        // record a processed key
+        matrix_prev[key.row] ^= col_mask;
+
+        switch_events(key.row, key.col, pressed);
+    }
+
+    return count;
+}
+
+#ifdef MATRIX_IDLE_SLEEP
+static bool keyboard_busy = false;
+
+void keyboard_task_busy(void) { keyboard_busy = true; }
+#endif
+
 /** \brief Keyboard task: Do keyboard routine jobs
  *
  * Do routine keyboard jobs:
@@ -384,13 +548,7 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
  * This is repeatedly called as fast as possible.
  */
 void keyboard_task(void) {
-    static matrix_row_t matrix_prev[MATRIX_ROWS];
-    static uint8_t      led_status    = 0;
-    matrix_row_t        matrix_row    = 0;
-    matrix_row_t        matrix_change = 0;
-#ifdef QMK_KEYS_PER_SCAN
-    uint8_t keys_processed = 0;
-#endif
+    static uint8_t led_status = 0;
 #ifdef ENCODER_ENABLE
     bool encoders_changed = false;
 #endif
@@ -398,50 +556,17 @@ void keyboard_task(void) {
     uint8_t matrix_changed = matrix_scan();
     if (matrix_changed) last_matrix_activity_trigger();
 
-    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
-        matrix_row    = matrix_get_row(r);
-        matrix_change = matrix_row ^ matrix_prev[r];
-        if (matrix_change) {
-#ifdef MATRIX_HAS_GHOST
-            if (has_ghost_in_row(r, matrix_row)) {
-                continue;
-            }
+#ifdef DEBUG_MATRIX_SCAN_RATE
+    uint32_t matrix_task_start = timer_read_us32();
 #endif
-            if (debug_matrix) matrix_print();
-            matrix_row_t col_mask = 1;
-            for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
-                if (matrix_change & col_mask) {
-                    if (should_process_keypress()) {
-                        action_exec((keyevent_t){
-                            .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = (timer_read() | 1) /* time should not be 0 */
-                        });
-                    }
-                    // record a processed key
-                    matrix_prev[r] ^= col_mask;
-
-                    switch_events(r, c, (matrix_row & col_mask));
-
-#ifdef QMK_KEYS_PER_SCAN
-                    // only jump out if we have processed "enough" keys.
-                    if (++keys_processed >= QMK_KEYS_PER_SCAN)
-#endif
-                        // process a key per task call
-                        goto MATRIX_LOOP_END;
-                }
-            }
-        }
-    }
+    uint16_t keys_processed = matrix_task();
     // call with pseudo tick event when no real key event.
-#ifdef QMK_KEYS_PER_SCAN
-    // we can get here with some keys processed now.
-    if (!keys_processed)
-#endif
+    if (!keys_processed) {
         action_exec(TICK);
-
-MATRIX_LOOP_END:
+    }
 
 #ifdef DEBUG_MATRIX_SCAN_RATE
-    matrix_scan_perf_task();
+    matrix_scan_perf_task(keys_processed, TIMER_DIFF_32(timer_read_us32(), matrix_task_start));
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
@@ -542,6 +667,14 @@ MATRIX_LOOP_END:
         led_status = host_keyboard_leds();
         keyboard_set_leds(led_status);
     }
+
+#ifdef MATRIX_IDLE_SLEEP
+    // nothing to do until a key changes or the next timer tick, unless a task has work left
+    if (!keys_processed && !keyboard_busy) {
+        matrix_idle_sleep();
+    }
+    keyboard_busy = false;
+#endif
 }
 
 /** \brief keyboard set leds
@@ -60,6 +60,12 @@ void keyboard_init(void);
 void keyboard_task(void);
 /* it runs when host LED status is updated */
 void keyboard_set_leds(uint8_t leds);
+#ifdef MATRIX_IDLE_SLEEP
+/* tasks that have work left for the next keyboard_task() call it, so it doesn't sleep in between */
+void keyboard_task_busy(void);
+#else
+#    define keyboard_task_busy()
+#endif
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
@@ -83,7 +89,9 @@ uint32_t last_matrix_activity_elapsed(void);  // Number of milliseconds since th
 uint32_t last_encoder_activity_time(void);     // Timestamp of the last encoder activity
 uint32_t last_encoder_activity_elapsed(void);  // Number of milliseconds since the last encoder activity
 
-uint32_t get_matrix_scan_rate(void);
+uint32_t get_matrix_scan_rate(void);      // Number of matrix scans in the last second (DEBUG_MATRIX_SCAN_RATE)
+uint16_t get_matrix_scan_max_keys(void);  // Most key events processed by a single scan in the last second (DEBUG_MATRIX_SCAN_RATE)
+uint32_t get_matrix_task_max_time(void);  // Longest time in microseconds a single scan took to process its key events in the last second (DEBUG_MATRIX_SCAN_RATE)
 
 #ifdef __cplusplus
 }
@@ -13,6 +13,13 @@ void suspend_wakeup_init_kb(void);
 void suspend_power_down_user(void);
 void suspend_power_down_kb(void);
 
+#ifdef MATRIX_IDLE_SLEEP
+#    include "gpio.h"
+
+/* let a falling edge on pin wake the MCU from suspend_idle(), from now on; false if it can't */
+bool suspend_wakeup_pin_enable(pin_t pin);
+#endif
+
 #ifndef USB_SUSPEND_WAKEUP_DELAY
 #    define USB_SUSPEND_WAKEUP_DELAY 0
 #endif